@@ -0,0 +1,218 @@
+/*
+ * A2ABlockEngine.hpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+#ifndef Hadrons_A2ABlockEngine_hpp_
+#define Hadrons_A2ABlockEngine_hpp_
+
+#include <Hadrons/Global.hpp>
+#include <Hadrons/TimerArray.hpp>
+
+BEGIN_HADRONS_NAMESPACE
+
+/******************************************************************************
+ *                 Blocked computation of A2A matrix sets                     *
+ ******************************************************************************/
+// Schedules the computation of a set of A2A matrices with nIdx mode indices
+// (2 for meson fields, 3 for nucleon fields). The index space is cut in blocks
+// of blockSize modes in every direction, visited in the given loop order
+// (outermost index first), and every block is cut in cache blocks of
+// cacheBlockSize modes. The engine owns the loops, the timers and the
+// performance logs, the computation itself is delegated to a policy object
+// with the following members:
+//
+//   void   beginBlock(const Index &start, const Index &size);
+//   void   kernel(const Index &start, const Index &cStart, const Index &cSize,
+//                 double &time);
+//   void   copy(const Index &cStart, const Index &cSize);
+//   double flops(const Index &cSize);
+//   double bytes(const Index &cSize);
+//   void   endBlock(const Index &start, const Index &size);
+//
+// kernel computes the cache block at start + cStart into the policy cache and
+// returns the kernel time in us, copy moves it at cStart in the block buffer,
+// and endBlock is where the block is written.
+template <unsigned int nIdx>
+class A2ABlockEngine
+{
+public:
+    typedef std::array<unsigned int, nIdx> Index;
+public:
+    // constructor
+    A2ABlockEngine(GridBase *grid, const unsigned int blockSize,
+                   const unsigned int cacheBlockSize, TimerArray *tArray = nullptr);
+    // loop order 0, 1, ..., nIdx - 1
+    static Index defaultOrder(void);
+    // run the policy over the index space [0, N[
+    template <typename Policy>
+    void run(const Index &N, Policy &policy,
+             const Index &order = defaultOrder()) const;
+private:
+    template <typename Visitor>
+    static void forEachBlock(const Index &N, const unsigned int step,
+                             const Index &order, Visitor &&visit);
+    static std::string rangeString(const Index &start, const Index &size);
+private:
+    GridBase     *grid_;
+    unsigned int blockSize_, cacheBlockSize_;
+    TimerArray   *tArray_;
+};
+
+/******************************************************************************
+ *                    A2ABlockEngine template implementation                  *
+ ******************************************************************************/
+template <unsigned int nIdx>
+A2ABlockEngine<nIdx>::A2ABlockEngine(GridBase *grid,
+                                     const unsigned int blockSize,
+                                     const unsigned int cacheBlockSize,
+                                     TimerArray *tArray)
+: grid_(grid), blockSize_(blockSize), cacheBlockSize_(cacheBlockSize)
+, tArray_(tArray)
+{
+    if ((blockSize_ == 0) or (cacheBlockSize_ == 0))
+    {
+        HADRONS_ERROR(Size, "A2A block sizes must be non-zero");
+    }
+}
+
+template <unsigned int nIdx>
+typename A2ABlockEngine<nIdx>::Index A2ABlockEngine<nIdx>::defaultOrder(void)
+{
+    Index order;
+
+    for (unsigned int d = 0; d < nIdx; ++d)
+    {
+        order[d] = d;
+    }
+
+    return order;
+}
+
+// odometer over the blocks of [0, N[, the last index of order runs fastest
+template <unsigned int nIdx>
+template <typename Visitor>
+void A2ABlockEngine<nIdx>::forEachBlock(const Index &N, const unsigned int step,
+                                        const Index &order, Visitor &&visit)
+{
+    Index start, size;
+    int   l;
+
+    for (unsigned int d = 0; d < nIdx; ++d)
+    {
+        if (N[d] == 0)
+        {
+            return;
+        }
+        start[d] = 0;
+    }
+    do
+    {
+        for (unsigned int d = 0; d < nIdx; ++d)
+        {
+            size[d] = std::min(step, N[d] - start[d]);
+        }
+        visit(start, size);
+        for (l = nIdx - 1; l >= 0; --l)
+        {
+            const unsigned int d = order[l];
+
+            start[d] += step;
+            if (start[d] < N[d])
+            {
+                break;
+            }
+            start[d] = 0;
+        }
+    } while (l >= 0);
+}
+
+template <unsigned int nIdx>
+std::string A2ABlockEngine<nIdx>::rangeString(const Index &start, const Index &size)
+{
+    std::string s = "[";
+
+    for (unsigned int d = 0; d < nIdx; ++d)
+    {
+        s += std::to_string(start[d]) + " .. "
+             + std::to_string(start[d] + size[d] - 1)
+             + ((d + 1 < nIdx) ? ", " : "]");
+    }
+
+    return s;
+}
+
+#define START_TIMER(name) if (tArray_) tArray_->startTimer(name)
+#define STOP_TIMER(name)  if (tArray_) tArray_->stopTimer(name)
+
+template <unsigned int nIdx>
+template <typename Policy>
+void A2ABlockEngine<nIdx>::run(const Index &N, Policy &policy,
+                               const Index &order) const
+{
+    const double nodes  = grid_->NodeCount();
+    unsigned int nBlock = 1, iBlock = 0;
+
+    for (unsigned int d = 0; d < nIdx; ++d)
+    {
+        nBlock *= N[d]/blockSize_ + (((N[d] % blockSize_) != 0) ? 1 : 0);
+    }
+    forEachBlock(N, blockSize_, order,
+                 [&](const Index &start, const Index &size)
+    {
+        double flops = 0., bytes = 0., tKernel = 0.;
+
+        iBlock++;
+        policy.beginBlock(start, size);
+        LOG(Message) << "All-to-all matrix block " << iBlock << "/" << nBlock
+                     << " " << rangeString(start, size) << std::endl;
+        // series of cache blocked chunks of the contractions within this block
+        forEachBlock(size, cacheBlockSize_, defaultOrder(),
+                     [&](const Index &cStart, const Index &cSize)
+        {
+            double t;
+
+            START_TIMER("kernel");
+            policy.kernel(start, cStart, cSize, t);
+            STOP_TIMER("kernel");
+            tKernel += t;
+            flops   += policy.flops(cSize);
+            bytes   += policy.bytes(cSize);
+            START_TIMER("cache copy");
+            policy.copy(cStart, cSize);
+            STOP_TIMER("cache copy");
+        });
+        // perf
+        LOG(Message) << "Kernel perf " << flops/tKernel/1.0e3/nodes
+                     << " Gflop/s/node " << std::endl;
+        LOG(Message) << "Kernel perf " << bytes/tKernel*1.0e6/1024/1024/1024/nodes
+                     << " GB/s/node "  << std::endl;
+        // IO
+        policy.endBlock(start, size);
+    });
+}
+
+#undef START_TIMER
+#undef STOP_TIMER
+
+END_HADRONS_NAMESPACE
+
+#endif // Hadrons_A2ABlockEngine_hpp_
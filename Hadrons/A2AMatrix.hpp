@@ -31,6 +31,8 @@
 
 #include <Hadrons/Global.hpp>
 #include <Hadrons/TimerArray.hpp>
+#include <Hadrons/Database.hpp>
+#include <Hadrons/A2ABlockEngine.hpp>
 #include <Grid/Eigen/unsupported/CXX11/Tensor>
 #ifdef USE_MKL
 #include "mkl.h"
@@ -47,6 +49,26 @@
 
 #define HADRONS_A2AM_PARALLEL_IO
 
+// number of blocks gathered before writing them to disk
+#ifndef HADRONS_A2AM_IO_BATCH
+#define HADRONS_A2AM_IO_BATCH 1
+#endif
+
+// with HADRONS_A2AM_COLLECTIVE_IO, all ranks write a share of every block of
+// every file through parallel HDF5
+#if defined(HADRONS_A2AM_COLLECTIVE_IO) && defined(HAVE_HDF5) && !defined(H5_HAVE_PARALLEL)
+#error "HADRONS_A2AM_COLLECTIVE_IO needs a parallel HDF5 library"
+#endif
+
+#ifndef HADRONS_A2AM_TUNE_TABLE
+#define HADRONS_A2AM_TUNE_TABLE "a2aBlockTuning"
+#endif
+
+// largest cache block size tried by the block size tuning
+#ifndef HADRONS_A2AM_TUNE_MAX_CACHE
+#define HADRONS_A2AM_TUNE_MAX_CACHE 32
+#endif
+
 BEGIN_HADRONS_NAMESPACE
 
 // general A2A matrix set based on Eigen tensors and Grid-allocated memory
@@ -103,6 +125,12 @@ public:
 template <typename T>
 class A2AMatrixIo
 {
+public:
+    // position of a nt*ni*nj block in the nt*N_i*N_j matrix
+    struct BlockPos
+    {
+        unsigned int i, j, ni, nj;
+    };
 public:
     // constructors
     A2AMatrixIo(void) = default;
@@ -124,6 +152,10 @@ public:
                    const unsigned int blockSizei, const unsigned int blockSizej);
     void saveBlock(const A2AMatrixSet<T> &m, const unsigned int ext, const unsigned int str,
                    const unsigned int i, const unsigned int j);
+    // collective write of several blocks by all the ranks of grid, each rank
+    // writing a contiguous share of the (t, i) rows of every block
+    void saveBlocks(const std::vector<const T *> &data,
+                    const std::vector<BlockPos> &pos, GridBase *grid);
     template <template <class> class Vec, typename VecT>
     void load(Vec<VecT> &v, double *tRead = nullptr, GridBase *grid = nullptr);
     template <template <class> class Vec, typename VecT>
@@ -136,6 +168,15 @@ private:
 /******************************************************************************
  *                  Wrapper for A2A matrix block computation                  *
  ******************************************************************************/
+// database entry for tuned block sizes
+struct A2ABlockTuneEntry: SqlEntry
+{
+    HADRONS_SQL_FIELDS(SqlUnique<SqlNotNull<std::string>>, key,
+                       SqlNotNull<unsigned int>          , block,
+                       SqlNotNull<unsigned int>          , cacheBlock,
+                       double                            , gflops);
+};
+
 template <typename T, typename Field, typename MetadataType, typename TIo = T>
 class A2AMatrixBlockComputation
 {
@@ -148,6 +189,13 @@ private:
     };
     typedef std::function<std::string(const unsigned int, const unsigned int)>  FilenameFn;
     typedef std::function<MetadataType(const unsigned int, const unsigned int)> MetadataFn;
+    // fill buf[0 .. n-1] with the A2A vectors i .. i+n-1
+    typedef std::function<void(std::vector<Field> &, const unsigned int, 
+                               const unsigned int)>                             VectorFn;
+    // run the kernel on a n_i x n_j cache block (see tune)
+    typedef std::function<void(A2AMatrixSet<T> &, const unsigned int,
+                               const unsigned int, double &)>                   TrialFn;
+    typedef typename A2ABlockEngine<2>::Index                                   BlockIndex;
 public:
     // constructor
     A2AMatrixBlockComputation(GridBase *grid,
@@ -164,6 +212,18 @@ public:
                  const FilenameFn &ionameFn,
                  const FilenameFn &filenameFn,
                  const MetadataFn &metadataFn);
+    // streaming version where the vectors are generated block by block in
+    // leftBuf/rightBuf (size >= blockSize) and never stored in full
+    void execute(const unsigned int N_i,
+                 const unsigned int N_j,
+                 std::vector<Field> &leftBuf,
+                 std::vector<Field> &rightBuf,
+                 const VectorFn &leftFn,
+                 const VectorFn &rightFn,
+                 A2AKernel<T, Field> &kernel,
+                 const FilenameFn &ionameFn,
+                 const FilenameFn &filenameFn,
+                 const MetadataFn &metadataFn);
     // for Staggered Conserved Current
     void execute(int mu,
                  const LatticeColourMatrix Umu,
@@ -186,9 +246,125 @@ public:
                  const FilenameFn &ionameFn,
                  const FilenameFn &filenameFn,
                  const MetadataFn &metadataFn);
+    // block sizes
+    unsigned int getBlockSize(void) const;
+    unsigned int getCacheBlockSize(void) const;
+    void         setBlockSize(const unsigned int blockSize,
+                              const unsigned int cacheBlockSize);
+    // tune the block sizes for N_i x N_j matrices with short trial kernels,
+    // the block size is at most maxBlock and the buffers (including the trial
+    // buffer) can grow by at most memoryBudget bytes. The cache block sizes
+    // tried are bounded by the current block size and
+    // HADRONS_A2AM_TUNE_MAX_CACHE. If db is connected, the result is stored
+    // there per kernel and geometry and reused in later runs.
+    void tune(const std::string kernelName, const unsigned int N_i,
+              const unsigned int N_j, const unsigned int maxBlock,
+              A2AKernel<T, Field> &kernel, const TrialFn &trial,
+              const size_t memoryBudget, Database *db = nullptr);
+    void tune(const std::string kernelName, const std::vector<Field> &left,
+              const std::vector<Field> &right, A2AKernel<T, Field> &kernel,
+              const size_t memoryBudget, Database *db = nullptr);
 private:
+    // block engine policy (see A2ABlockEngine.hpp): call(m, start, cStart, t)
+    // runs the kernel on the cache block at start + cStart, prepare(start,
+    // size) is called before each block
+    template <typename KernelCall, typename PrepareFn>
+    class BlockPolicy
+    {
+    public:
+        BlockPolicy(A2AMatrixBlockComputation &c, A2AKernel<T, Field> &kernel,
+                    const KernelCall &call, const PrepareFn &prepare,
+                    const BlockIndex &N, const FilenameFn &ionameFn,
+                    const FilenameFn &filenameFn, const MetadataFn &metadataFn)
+        : c_(c), kernel_(kernel), call_(call), prepare_(prepare), N_(N)
+        , ionameFn_(ionameFn), filenameFn_(filenameFn), metadataFn_(metadataFn)
+        {}
+        void beginBlock(const BlockIndex &start, const BlockIndex &size)
+        {
+            size_ = size;
+            prepare_(start, size);
+        }
+        void kernel(const BlockIndex &start, const BlockIndex &cStart,
+                    const BlockIndex &cSize, double &time)
+        {
+            A2AMatrixSet<T> mCacheBlock(c_.mCache_.data(), c_.next_, c_.nstr_,
+                                        c_.nt_, cSize[0], cSize[1]);
+
+            call_(mCacheBlock, start, cStart, time);
+        }
+        void copy(const BlockIndex &cStart, const BlockIndex &cSize)
+        {
+            const unsigned int next = c_.next_, nstr = c_.nstr_, nt = c_.nt_;
+            const int          ii = cStart[0], jj = cStart[1];
+            const int          N_iii = cSize[0], N_jjj = cSize[1];
+            A2AMatrixSet<T>    mCacheBlock(c_.mCache_.data(), next, nstr, nt, 
+                                           N_iii, N_jjj);
+            A2AMatrixSet<TIo>  mBlock(c_.mBuf_.data(), next, nstr, nt, 
+                                      size_[0], size_[1]);
+
+            thread_for_collapse( 5,e,next,{
+              for(int s =0;s< nstr;s++)
+              for(int t =0;t< nt;t++)
+              for(int iii=0;iii< N_iii;iii++)
+              for(int jjj=0;jjj< N_jjj;jjj++)
+              {
+                mBlock(e,s,t,ii+iii,jj+jjj) = mCacheBlock(e,s,t,iii,jjj);
+              }
+            });
+        }
+        double flops(const BlockIndex &cSize)
+        {
+            return kernel_.flops(cSize[0], cSize[1]);
+        }
+        double bytes(const BlockIndex &cSize)
+        {
+            return kernel_.bytes(cSize[0], cSize[1]);
+        }
+        void endBlock(const BlockIndex &start, const BlockIndex &size)
+        {
+            A2AMatrixSet<TIo> mBlock(c_.mBuf_.data(), c_.next_, c_.nstr_, c_.nt_,
+                                     size[0], size[1]);
+
+            c_.writeBlock(mBlock, start[0], start[1], N_[0], N_[1],
+                          ionameFn_, filenameFn_, metadataFn_);
+        }
+    private:
+        A2AMatrixBlockComputation &c_;
+        A2AKernel<T, Field>       &kernel_;
+        const KernelCall          &call_;
+        const PrepareFn           &prepare_;
+        BlockIndex                N_, size_;
+        const FilenameFn          &ionameFn_, &filenameFn_;
+        const MetadataFn          &metadataFn_;
+    };
+    struct NoPrepare
+    {
+        void operator()(const BlockIndex &, const BlockIndex &) const {}
+    };
+private:
+    // run a kernel call on all blocks
+    template <typename KernelCall, typename PrepareFn = NoPrepare>
+    void run(const BlockIndex &N, A2AKernel<T, Field> &kernel,
+             const KernelCall &call, const FilenameFn &ionameFn,
+             const FilenameFn &filenameFn, const MetadataFn &metadataFn,
+             const BlockIndex &order = A2ABlockEngine<2>::defaultOrder(),
+             const PrepareFn &prepare = PrepareFn());
+    // memory used by the block buffers
+    size_t bufferSize(const unsigned int blockSize,
+                      const unsigned int cacheBlockSize) const;
     // I/O handler
     void saveBlock(const A2AMatrixSet<TIo> &m, IoHelper &h);
+    void writeBlock(const A2AMatrixSet<TIo> &mBlock, 
+                    const unsigned int i, const unsigned int j,
+                    const unsigned int N_i, const unsigned int N_j,
+                    const FilenameFn &ionameFn, const FilenameFn &filenameFn,
+                    const MetadataFn &metadataFn);
+private:
+    struct PendingBlock
+    {
+        typename A2AMatrixIo<TIo>::BlockPos pos;
+        Vector<TIo>                         data;
+    };
 private:
     TimerArray            *tArray_;
     GridBase              *grid_;
@@ -196,6 +372,7 @@ private:
     Vector<T>             mCache_;
     Vector<TIo>           mBuf_;
     std::vector<IoHelper> nodeIo_;
+    std::vector<PendingBlock> pending_;
 };
 
 /******************************************************************************
@@ -647,6 +824,82 @@ void A2AMatrixIo<T>::saveBlock(const A2AMatrixSet<T> &m,
     saveBlock(m.data() + offset, i, j, blockSizei, blockSizej);
 }
 
+template <typename T>
+void A2AMatrixIo<T>::saveBlocks(const std::vector<const T *> &data,
+                                const std::vector<BlockPos> &pos, GridBase *grid)
+{
+#if defined(HAVE_HDF5) && defined(H5_HAVE_PARALLEL)
+    const unsigned int rank = grid->ThisRank(), nRank = grid->RankCount();
+    hid_t              fapl, dxpl, file, dset, type = Hdf5Type<T>::type().getId();
+    std::string        path = dataname_ + "/" + HADRONS_A2AM_NAME;
+
+    fapl = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl, grid->communicator, MPI_INFO_NULL);
+    dxpl = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+    file = H5Fopen(filename_.c_str(), H5F_ACC_RDWR, fapl);
+    if (file < 0)
+    {
+        HADRONS_ERROR(Io, "cannot open file '" + filename_ + "' for parallel write");
+    }
+    dset = H5Dopen(file, path.c_str(), H5P_DEFAULT);
+    for (unsigned int b = 0; b < data.size(); ++b)
+    {
+        // share of the nt*ni rows of the block for this rank, as at most
+        // three boxes (end of a time slice, full time slices, start of one)
+        const hsize_t  ni = pos[b].ni, nj = pos[b].nj, nRow = nt_*ni;
+        const hsize_t  r0 = nRow*rank/nRank, r1 = nRow*(rank + 1)/nRank;
+        const hsize_t  t0 = r0/ni, i0 = r0 % ni, t1 = r1/ni, i1 = r1 % ni;
+        hsize_t        nMem = (r1 - r0)*nj;
+        hid_t          fspace = H5Dget_space(dset), mspace;
+        H5S_seloper_t  op = H5S_SELECT_SET;
+        auto           box = [&](const hsize_t t, const hsize_t nt, 
+                                 const hsize_t i, const hsize_t n)
+        {
+            hsize_t offset[3] = {t, pos[b].i + i, pos[b].j};
+            hsize_t count[3]  = {nt, n, nj};
+
+            if ((nt > 0) and (n > 0))
+            {
+                H5Sselect_hyperslab(fspace, op, offset, nullptr, count, nullptr);
+                op = H5S_SELECT_OR;
+            }
+        };
+
+        if (t0 == t1)
+        {
+            box(t0, 1, i0, i1 - i0);
+        }
+        else
+        {
+            box(t0, 1, i0, ni - i0);
+            box(t0 + 1, t1 - t0 - 1, 0, ni);
+            box(t1, 1, 0, i1);
+        }
+        if (nMem == 0)
+        {
+            H5Sselect_none(fspace);
+            nMem   = 1;
+            mspace = H5Screate_simple(1, &nMem, nullptr);
+            H5Sselect_none(mspace);
+        }
+        else
+        {
+            mspace = H5Screate_simple(1, &nMem, nullptr);
+        }
+        H5Dwrite(dset, type, mspace, fspace, dxpl, data[b] + r0*nj);
+        H5Sclose(mspace);
+        H5Sclose(fspace);
+    }
+    H5Dclose(dset);
+    H5Fclose(file);
+    H5Pclose(dxpl);
+    H5Pclose(fapl);
+#else
+    HADRONS_ERROR(Implementation, "collective all-to-all matrix I/O needs a parallel HDF5 library");
+#endif
+}
+
 template <typename T>
 template <template <class> class Vec, typename VecT>
 void A2AMatrixIo<T>::load(Vec<VecT> &v, double *tRead, GridBase *grid)
@@ -838,141 +1091,323 @@ A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
     mBuf_.resize(nt_*next_*nstr_*blockSize_*blockSize_);
 }
 
-#define START_TIMER(name) if (tArray_) tArray_->startTimer(name)
-#define STOP_TIMER(name)  if (tArray_) tArray_->stopTimer(name)
-#define GET_TIMER(name)   ((tArray_ != nullptr) ? tArray_->getDTimer(name) : 0.)
+// block sizes ////////////////////////////////////////////////////////////////
+template <typename T, typename Field, typename MetadataType, typename TIo>
+unsigned int A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
+::getBlockSize(void) const
+{
+    return blockSize_;
+}
+
+template <typename T, typename Field, typename MetadataType, typename TIo>
+unsigned int A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
+::getCacheBlockSize(void) const
+{
+    return cacheBlockSize_;
+}
 
-// execution ///////////////////////////////////////////////////////////////////
 template <typename T, typename Field, typename MetadataType, typename TIo>
 void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
-::execute(const std::vector<Field> &left, const std::vector<Field> &right,
-          A2AKernel<T, Field> &kernel, const FilenameFn &ionameFn,
-          const FilenameFn &filenameFn, const MetadataFn &metadataFn)
+::setBlockSize(const unsigned int blockSize, const unsigned int cacheBlockSize)
 {
-    //////////////////////////////////////////////////////////////////////////
-    // i,j   is first  loop over blockSize_ factors
-    // ii,jj is second loop over cacheBlockSize_ factors for high perf contractions
-    // iii,jjj are loops within cacheBlock
-    // Total index is sum of these  i+ii+iii etc...
-    //////////////////////////////////////////////////////////////////////////
-    int    N_i = left.size();
-    int    N_j = right.size();
-    double flops, bytes, t_kernel;
-    double nodes = grid_->NodeCount();
-    
-    int NBlock_i = N_i/blockSize_ + (((N_i % blockSize_) != 0) ? 1 : 0);
-    int NBlock_j = N_j/blockSize_ + (((N_j % blockSize_) != 0) ? 1 : 0);
+    if ((blockSize == 0) or (cacheBlockSize == 0) or (cacheBlockSize > blockSize))
+    {
+        HADRONS_ERROR(Argument, "invalid block sizes (block " 
+                      + std::to_string(blockSize) + ", cache block " 
+                      + std::to_string(cacheBlockSize) + ")");
+    }
+    blockSize_      = blockSize;
+    cacheBlockSize_ = cacheBlockSize;
+    mCache_.resize(nt_*next_*nstr_*cacheBlockSize_*cacheBlockSize_);
+    mBuf_.resize(nt_*next_*nstr_*blockSize_*blockSize_);
+}
+
+template <typename T, typename Field, typename MetadataType, typename TIo>
+size_t A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
+::bufferSize(const unsigned int blockSize, const unsigned int cacheBlockSize) const
+{
+    size_t n = nt_*next_*nstr_;
+
+    return n*blockSize*blockSize*sizeof(TIo) 
+           + n*cacheBlockSize*cacheBlockSize*sizeof(T);
+}
+
+// tuning //////////////////////////////////////////////////////////////////////
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
+::tune(const std::string kernelName, const unsigned int N_i,
+       const unsigned int N_j, const unsigned int maxBlock,
+       A2AKernel<T, Field> &kernel, const TrialFn &trial,
+       const size_t memoryBudget, Database *db)
+{
+    // all ranks must try the same candidates and agree on the result, the
+    // trial kernels and the block computation being collective
+    const size_t           avail  = [this, memoryBudget](void)
+    {
+        size_t b = memoryBudget;
+
+        grid_->Broadcast(grid_->BossRank(), &b, sizeof(b));
+
+        return b;
+    }();
+    const unsigned int     nMax   = std::min(maxBlock, std::min(N_i, N_j));
+    const size_t           budget = avail + bufferSize(blockSize_, cacheBlockSize_);
+    const double           nodes  = grid_->NodeCount();
+    std::string            key    = kernelName + " ";
+    std::set<unsigned int> candidate;
+    unsigned int           bestBlock = 0, bestCache = 0;
+    double                 bestPerf  = 0.;
+
+    // key: kernel, lattice and MPI geometry, matrix set size
+    for (unsigned int mu = 0; mu < grid_->_ndimension; ++mu)
+    {
+        key += std::to_string(grid_->_fdimensions[mu]) 
+               + ((mu == grid_->_ndimension - 1) ? "/" : ".");
+    }
+    for (unsigned int mu = 0; mu < grid_->_ndimension; ++mu)
+    {
+        key += std::to_string(grid_->_processors[mu]) 
+               + ((mu == grid_->_ndimension - 1) ? " " : ".");
+    }
+    key += std::to_string(next_) + "x" + std::to_string(nstr_);
 
-    for(int i=0;i<N_i;i+=blockSize_)
-    for(int j=0;j<N_j;j+=blockSize_)
+    // previous result
+    if (db and db->tableExists(HADRONS_A2AM_TUNE_TABLE))
     {
-        // Get the W and V vectors for this block^2 set of terms
-        int N_ii = MIN(N_i-i,blockSize_);
-        int N_jj = MIN(N_j-j,blockSize_);
-        A2AMatrixSet<TIo> mBlock(mBuf_.data(), next_, nstr_, nt_, N_ii, N_jj);
-
-        LOG(Message) << "All-to-all matrix block " 
-                     << j/blockSize_ + NBlock_j*i/blockSize_ + 1 
-                     << "/" << NBlock_i*NBlock_j << " [" << i <<" .. " 
-                     << i+N_ii-1 << ", " << j <<" .. " << j+N_jj-1 << "]" 
-                     << std::endl;
-        // Series of cache blocked chunks of the contractions within this block
-        flops    = 0.0;
-        bytes    = 0.0;
-        t_kernel = 0.0;
-        for(int ii=0;ii<N_ii;ii+=cacheBlockSize_)
-        for(int jj=0;jj<N_jj;jj+=cacheBlockSize_)
+        auto table = db->getTable<A2ABlockTuneEntry>(HADRONS_A2AM_TUNE_TABLE,
+                                                     "WHERE key = '" + key + "'");
+
+        if (!table.empty() and (table[0].block <= nMax) 
+            and (bufferSize(table[0].block, table[0].cacheBlock) <= budget))
         {
-            double t;
-            int N_iii = MIN(N_ii-ii,cacheBlockSize_);
-            int N_jjj = MIN(N_jj-jj,cacheBlockSize_);
-            A2AMatrixSet<T> mCacheBlock(mCache_.data(), next_, nstr_, nt_, N_iii, N_jjj);
-
-            START_TIMER("kernel");
-            kernel(mCacheBlock, &left[i+ii], &right[j+jj], orthogDim_, t);
-            STOP_TIMER("kernel");
-            t_kernel += t;
-            flops    += kernel.flops(N_iii, N_jjj);
-            bytes    += kernel.bytes(N_iii, N_jjj);
-
-            START_TIMER("cache copy");
-            thread_for_collapse( 5,e,next_,{
-              for(int s =0;s< nstr_;s++)
-              for(int t =0;t< nt_;t++)
-              for(int iii=0;iii< N_iii;iii++)
-              for(int jjj=0;jjj< N_jjj;jjj++)
-              {
-                mBlock(e,s,t,ii+iii,jj+jjj) = mCacheBlock(e,s,t,iii,jjj);
-              }
-            });
-            STOP_TIMER("cache copy");
+            LOG(Message) << "A2A block sizes for '" << key 
+                         << "' from database: block " << table[0].block
+                         << ", cache block " << table[0].cacheBlock
+                         << " (" << table[0].gflops << " Gflop/s/node)" 
+                         << std::endl;
+            setBlockSize(table[0].block, table[0].cacheBlock);
+
+            return;
         }
+    }
 
-        // perf
-        LOG(Message) << "Kernel perf " << flops/t_kernel/1.0e3/nodes 
-                     << " Gflop/s/node " << std::endl;
-        LOG(Message) << "Kernel perf " << bytes/t_kernel*1.0e6/1024/1024/1024/nodes 
-                     << " GB/s/node "  << std::endl;
+    // trial kernels on each cache block size, the block size being the
+    // largest multiple of the cache block fitting in the memory budget
+    const unsigned int cMax = std::min(nMax, 
+        std::min(blockSize_, static_cast<unsigned int>(HADRONS_A2AM_TUNE_MAX_CACHE)));
+    const size_t       trialUnit = nt_*next_*nstr_*sizeof(T);
+    unsigned int       nTrial = 0;
 
-        // IO
-        double       blockSize, ioTime;
-        unsigned int myRank = grid_->ThisRank(), nRank  = grid_->RankCount();
-    
-        LOG(Message) << "Writing block to disk" << std::endl;
-        ioTime = -GET_TIMER("IO: write block");
-        START_TIMER("IO: total");
-        makeFileDir(filenameFn(0, 0), grid_);
-#ifdef HADRONS_A2AM_PARALLEL_IO
-        grid_->Barrier();
-        // make task list for current node
-        nodeIo_.clear();
-        for(int f = myRank; f < next_*nstr_; f += nRank)
+    for (unsigned int c = 4; c <= cMax; c *= 2)
+    {
+        candidate.insert(c);
+    }
+    candidate.insert(std::min(cacheBlockSize_, cMax));
+    // the trial buffer is allocated on top of the current buffers
+    for (auto it = candidate.begin(); it != candidate.end(); )
+    {
+        if ((*it == 0) or (trialUnit*(*it)*(*it) > avail))
         {
-            IoHelper h;
-
-            h.i  = i;
-            h.j  = j;
-            h.e  = f/nstr_;
-            h.s  = f % nstr_;
-            h.io = A2AMatrixIo<TIo>(filenameFn(h.e, h.s), 
-                                    ionameFn(h.e, h.s), nt_, N_i, N_j);
-            h.md = metadataFn(h.e, h.s);
-            nodeIo_.push_back(h);
+            it = candidate.erase(it);
         }
-        // parallel IO
-        for (auto &h: nodeIo_)
+        else
         {
-            saveBlock(mBlock, h);
+            ++it;
         }
-        grid_->Barrier();
-#else
-        // serial IO, for testing purposes only
-        for(int e = 0; e < next_; e++)
-        for(int s = 0; s < nstr_; s++)
+    }
+    if (candidate.empty())
+    {
+        LOG(Warning) << "no A2A trial buffer fits in the memory budget, keeping"
+                     << " block " << blockSize_ << ", cache block " 
+                     << cacheBlockSize_ << std::endl;
+
+        return;
+    }
+    // all candidates are timed on the same nTrial x nTrial sub-block
+    nTrial = *candidate.rbegin();
+
+    Vector<T> buf(trialUnit/sizeof(T)*nTrial*nTrial);
+
+    LOG(Message) << "Tuning A2A block sizes for '" << key << "' (budget " 
+                 << sizeString(budget) << ", trial sub-block " << nTrial 
+                 << ")" << std::endl;
+    for (auto c: candidate)
+    {
+        unsigned int    b = (nMax/c)*c, nCall;
+        double          t = 0., flops = 0., perf;
+        A2AMatrixSet<T> m(buf.data(), next_, nstr_, nt_, c, c);
+
+        while ((b >= c) and (bufferSize(b, c) > budget))
         {
-            IoHelper h;
-
-            h.i  = i;
-            h.j  = j;
-            h.e  = e;
-            h.s  = s;
-            h.io = A2AMatrixIo<TIo>(filenameFn(h.e, h.s), 
-                                    ionameFn(h.e, h.s), nt_, N_i, N_j);
-            h.md = metadataFn(h.e, h.s);
-            saveBlock(mfBlock, h);
+            b -= c;
         }
-#endif
-        STOP_TIMER("IO: total");
-        blockSize  = static_cast<double>(next_*nstr_*nt_*N_ii*N_jj*sizeof(TIo));
-        ioTime    += GET_TIMER("IO: write block");
-        LOG(Message) << "HDF5 IO done " << sizeString(blockSize) << " in "
-                     << ioTime  << " us (" 
-                     << blockSize/ioTime*1.0e6/1024/1024
-                     << " MB/s)" << std::endl;
+        if (b < c)
+        {
+            continue;
+        }
+        nCall = ((nTrial + c - 1)/c)*((nTrial + c - 1)/c);
+        // first call as warm-up
+        trial(m, c, c, t);
+        t = 0.;
+        for (unsigned int n = 0; n < nCall; ++n)
+        {
+            double tCall = 0.;
+
+            trial(m, c, c, tCall);
+            t     += tCall;
+            flops += kernel.flops(c, c);
+        }
+        // slowest rank
+        grid_->GlobalMax(t);
+        perf = flops/t/1.0e3/nodes;
+        LOG(Message) << "  cache block " << std::setw(4) << c << " block " 
+                     << std::setw(5) << b << ": " << perf << " Gflop/s/node" 
+                     << std::endl;
+        if (perf > bestPerf)
+        {
+            bestPerf  = perf;
+            bestBlock = b;
+            bestCache = c;
+        }
+    }
+    {
+        unsigned int best[2] = {bestBlock, bestCache};
+
+        grid_->Broadcast(grid_->BossRank(), best, sizeof(best));
+        bestBlock = best[0];
+        bestCache = best[1];
+    }
+    if (bestBlock == 0)
+    {
+        LOG(Warning) << "no A2A block sizes fit in the memory budget, keeping"
+                     << " block " << blockSize_ << ", cache block " 
+                     << cacheBlockSize_ << std::endl;
+
+        return;
+    }
+    LOG(Message) << "Tuned A2A block sizes: block " << bestBlock 
+                 << ", cache block " << bestCache << std::endl;
+    setBlockSize(bestBlock, bestCache);
+    if (db)
+    {
+        A2ABlockTuneEntry e;
+
+        if (!db->tableExists(HADRONS_A2AM_TUNE_TABLE))
+        {
+            db->createTable<A2ABlockTuneEntry>(HADRONS_A2AM_TUNE_TABLE);
+        }
+        e.key        = key;
+        e.block      = bestBlock;
+        e.cacheBlock = bestCache;
+        e.gflops     = bestPerf;
+        db->insert(HADRONS_A2AM_TUNE_TABLE, e, true);
     }
 }
 
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
+::tune(const std::string kernelName, const std::vector<Field> &left,
+       const std::vector<Field> &right, A2AKernel<T, Field> &kernel,
+       const size_t memoryBudget, Database *db)
+{
+    auto trial = [this, &left, &right, &kernel](A2AMatrixSet<T> &m, 
+                                                const unsigned int, 
+                                                const unsigned int, double &t)
+    {
+        kernel(m, left.data(), right.data(), orthogDim_, t);
+    };
+
+    tune(kernelName, left.size(), right.size(), 
+         std::max(left.size(), right.size()), kernel, trial, memoryBudget, db);
+}
+
+#define START_TIMER(name) if (tArray_) tArray_->startTimer(name)
+#define STOP_TIMER(name)  if (tArray_) tArray_->stopTimer(name)
+#define GET_TIMER(name)   ((tArray_ != nullptr) ? tArray_->getDTimer(name) : 0.)
+
 // execution ///////////////////////////////////////////////////////////////////
+// All the execute variants run on the same block engine, they only differ by
+// the way the kernel is called on a cache block.
+template <typename T, typename Field, typename MetadataType, typename TIo>
+template <typename KernelCall, typename PrepareFn>
+void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
+::run(const BlockIndex &N, A2AKernel<T, Field> &kernel, const KernelCall &call,
+      const FilenameFn &ionameFn, const FilenameFn &filenameFn,
+      const MetadataFn &metadataFn, const BlockIndex &order,
+      const PrepareFn &prepare)
+{
+    A2ABlockEngine<2>                  engine(grid_, blockSize_, cacheBlockSize_, tArray_);
+    BlockPolicy<KernelCall, PrepareFn> policy(*this, kernel, call, prepare, N,
+                                              ionameFn, filenameFn, metadataFn);
+
+    engine.run(N, policy, order);
+}
+
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
+::execute(const std::vector<Field> &left, const std::vector<Field> &right,
+          A2AKernel<T, Field> &kernel, const FilenameFn &ionameFn,
+          const FilenameFn &filenameFn, const MetadataFn &metadataFn)
+{
+    auto call = [this, &left, &right, &kernel](A2AMatrixSet<T> &m,
+                                               const BlockIndex &s,
+                                               const BlockIndex &c, double &t)
+    {
+        kernel(m, &left[s[0] + c[0]], &right[s[1] + c[1]], orthogDim_, t);
+    };
+
+    run(BlockIndex{{static_cast<unsigned int>(left.size()),
+                    static_cast<unsigned int>(right.size())}},
+        kernel, call, ionameFn, filenameFn, metadataFn);
+}
+
+// streaming execution /////////////////////////////////////////////////////////
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
+::execute(const unsigned int N_i, const unsigned int N_j,
+          std::vector<Field> &leftBuf, std::vector<Field> &rightBuf,
+          const VectorFn &leftFn, const VectorFn &rightFn,
+          A2AKernel<T, Field> &kernel, const FilenameFn &ionameFn,
+          const FilenameFn &filenameFn, const MetadataFn &metadataFn)
+{
+    //////////////////////////////////////////////////////////////////////////
+    // same blocking as the stored-vector version, but the right block is the
+    // outer loop: each right vector is generated once, and the left vectors
+    // are regenerated for every right block. The right side should be the
+    // expensive one (e.g. V vectors, which need solves).
+    //////////////////////////////////////////////////////////////////////////
+    unsigned int jPrev = N_j;
+
+    if ((leftBuf.size() < MIN(N_i, blockSize_)) 
+        or (rightBuf.size() < MIN(N_j, blockSize_)))
+    {
+        HADRONS_ERROR(Size, "vector buffers smaller than block size");
+    }
+    auto prepare = [&](const BlockIndex &start, const BlockIndex &size)
+    {
+        if (start[1] != jPrev)
+        {
+            START_TIMER("right vectors");
+            rightFn(rightBuf, start[1], size[1]);
+            STOP_TIMER("right vectors");
+            jPrev = start[1];
+        }
+        START_TIMER("left vectors");
+        leftFn(leftBuf, start[0], size[0]);
+        STOP_TIMER("left vectors");
+    };
+    auto call = [this, &leftBuf, &rightBuf, &kernel](A2AMatrixSet<T> &m,
+                                                     const BlockIndex &,
+                                                     const BlockIndex &c, double &t)
+    {
+        kernel(m, &leftBuf[c[0]], &rightBuf[c[1]], orthogDim_, t);
+    };
+
+    run(BlockIndex{{N_i, N_j}}, kernel, call, ionameFn, filenameFn, metadataFn,
+        BlockIndex{{1, 0}}, prepare);
+}
+
+// staggered conserved current execution ///////////////////////////////////////
 template <typename T, typename Field, typename MetadataType, typename TIo>
 void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
 ::execute(int mu,
@@ -984,132 +1419,21 @@ void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
           const FilenameFn &filenameFn,
           const MetadataFn &metadataFn)
 {
-    //////////////////////////////////////////////////////////////////////////
-    // i,j   is first  loop over blockSize_ factors
-    // ii,jj is second loop over cacheBlockSize_ factors for high perf contractions
-    // iii,jjj are loops within cacheBlock
-    // Total index is sum of these  i+ii+iii etc...
-    //////////////////////////////////////////////////////////////////////////
     // only positive lambda vectors explicitly computed
-    int    N_i = 2*left.size();
-    int    N_j = 2*right.size();
-    double flops, bytes, t_kernel;
-    double nodes = grid_->NodeCount();
-    
-    int NBlock_i = N_i/blockSize_ + (((N_i % blockSize_) != 0) ? 1 : 0);
-    int NBlock_j = N_j/blockSize_ + (((N_j % blockSize_) != 0) ? 1 : 0);
-    
-    for(int i=0;i<N_i;i+=blockSize_)
-        for(int j=0;j<N_j;j+=blockSize_)
-        {
-            // Get the W and V vectors for this block^2 set of terms
-            int N_ii = MIN(N_i-i,blockSize_);
-            int N_jj = MIN(N_j-j,blockSize_);
-            A2AMatrixSet<TIo> mBlock(mBuf_.data(), next_, nstr_, nt_, N_ii, N_jj);
-            
-            LOG(Message) << "All-to-all matrix block "
-            << j/blockSize_ + NBlock_j*i/blockSize_ + 1
-            << "/" << NBlock_i*NBlock_j << " [" << i <<" .. "
-            << i+N_ii-1 << ", " << j <<" .. " << j+N_jj-1 << "]"
-            << std::endl;
-            // Series of cache blocked chunks of the contractions within this block
-            flops    = 0.0;
-            bytes    = 0.0;
-            t_kernel = 0.0;
-            for(int ii=0;ii<N_ii;ii+=cacheBlockSize_)
-                for(int jj=0;jj<N_jj;jj+=cacheBlockSize_)
-                {
-                    double t;
-                    int N_iii = MIN(N_ii-ii,cacheBlockSize_);
-                    int N_jjj = MIN(N_jj-jj,cacheBlockSize_);
-                    A2AMatrixSet<T> mCacheBlock(mCache_.data(), next_, nstr_, nt_, N_iii, N_jjj);
-                    
-                    START_TIMER("kernel");
-                    // only have the positve vectors
-                    kernel(mCacheBlock, mu, Umu, &left[(i+ii)/2], &right[(j+jj)/2], orthogDim_, t);
-                    STOP_TIMER("kernel");
-                    t_kernel += t;
-                    flops    += kernel.flops(N_iii, N_jjj);
-                    bytes    += kernel.bytes(N_iii, N_jjj);
-                    
-                    START_TIMER("cache copy");
-                    thread_for_collapse( 5,e,next_,{
-                        for(int s =0;s< nstr_;s++)
-                            for(int t =0;t< nt_;t++)
-                                for(int iii=0;iii< N_iii;iii++)
-                                    for(int jjj=0;jjj< N_jjj;jjj++)
-                                    {
-                                        mBlock(e,s,t,ii+iii,jj+jjj) = mCacheBlock(e,s,t,iii,jjj);
-                                    }
-                    });
-                    STOP_TIMER("cache copy");
-                }
-            
-            // perf
-            LOG(Message) << "Kernel perf " << flops/t_kernel/1.0e3/nodes
-            << " Gflop/s/node " << std::endl;
-            LOG(Message) << "Kernel perf " << bytes/t_kernel*1.0e6/1024/1024/1024/nodes
-            << " GB/s/node "  << std::endl;
-            
-            // IO
-            double       blockSize, ioTime;
-            unsigned int myRank = grid_->ThisRank(), nRank  = grid_->RankCount();
-            
-            LOG(Message) << "Writing block to disk" << std::endl;
-            ioTime = -GET_TIMER("IO: write block");
-            START_TIMER("IO: total");
-            makeFileDir(filenameFn(0, 0), grid_);
-#ifdef HADRONS_A2AM_PARALLEL_IO
-            grid_->Barrier();
-            // make task list for current node
-            nodeIo_.clear();
-            for(int f = myRank; f < next_*nstr_; f += nRank)
-            {
-                IoHelper h;
-                
-                h.i  = i;
-                h.j  = j;
-                h.e  = f/nstr_;
-                h.s  = f % nstr_;
-                h.io = A2AMatrixIo<TIo>(filenameFn(h.e, h.s),
-                                        ionameFn(h.e, h.s), nt_, N_i, N_j);
-                h.md = metadataFn(h.e, h.s);
-                nodeIo_.push_back(h);
-            }
-            // parallel IO
-            for (auto &h: nodeIo_)
-            {
-                saveBlock(mBlock, h);
-            }
-            grid_->Barrier();
-#else
-            // serial IO, for testing purposes only
-            for(int e = 0; e < next_; e++)
-                for(int s = 0; s < nstr_; s++)
-                {
-                    IoHelper h;
-                    
-                    h.i  = i;
-                    h.j  = j;
-                    h.e  = e;
-                    h.s  = s;
-                    h.io = A2AMatrixIo<TIo>(filenameFn(h.e, h.s),
-                                            ionameFn(h.e, h.s), nt_, N_i, N_j);
-                    h.md = metadataFn(h.e, h.s);
-                    saveBlock(mfBlock, h);
-                }
-#endif
-            STOP_TIMER("IO: total");
-            blockSize  = static_cast<double>(next_*nstr_*nt_*N_ii*N_jj*sizeof(TIo));
-            ioTime    += GET_TIMER("IO: write block");
-            LOG(Message) << "HDF5 IO done " << sizeString(blockSize) << " in "
-            << ioTime  << " us ("
-            << blockSize/ioTime*1.0e6/1024/1024
-            << " MB/s)" << std::endl;
-        }
+    auto call = [this, mu, &Umu, &left, &right, &kernel](A2AMatrixSet<T> &m,
+                                                         const BlockIndex &s,
+                                                         const BlockIndex &c,
+                                                         double &t)
+    {
+        kernel(m, mu, Umu, &left[(s[0] + c[0])/2], &right[(s[1] + c[1])/2],
+               orthogDim_, t);
+    };
+
+    run(BlockIndex{{static_cast<unsigned int>(2*left.size()),
+                    static_cast<unsigned int>(2*right.size())}},
+        kernel, call, ionameFn, filenameFn, metadataFn);
 }
 
-// execution ///////////////////////////////////////////////////////////////////
 template <typename T, typename Field, typename MetadataType, typename TIo>
 void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
 ::execute(int mu,
@@ -1125,131 +1449,17 @@ void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
           const FilenameFn &filenameFn,
           const MetadataFn &metadataFn)
 {
-    //////////////////////////////////////////////////////////////////////////
-    // i,j   is first  loop over blockSize_ factors
-    // ii,jj is second loop over cacheBlockSize_ factors for high perf contractions
-    // iii,jjj are loops within cacheBlock
-    // Total index is sum of these  i+ii+iii etc...
-    //////////////////////////////////////////////////////////////////////////
-    // only positive lambda vectors explicitly computed
-    int    N_i = levec.size();
-    int    N_j = revec.size();
-    double flops, bytes, t_kernel;
-    double nodes = grid_->NodeCount();
-    
-    int NBlock_i = N_i/blockSize_ + (((N_i % blockSize_) != 0) ? 1 : 0);
-    int NBlock_j = N_j/blockSize_ + (((N_j % blockSize_) != 0) ? 1 : 0);
-    
-    for(int i=0;i<N_i;i+=blockSize_)
-        for(int j=0;j<N_j;j+=blockSize_)
-        {
-            // Get the W and V vectors for this block^2 set of terms
-            int N_ii = MIN(N_i-i,blockSize_);
-            int N_jj = MIN(N_j-j,blockSize_);
-            A2AMatrixSet<TIo> mBlock(mBuf_.data(), next_, nstr_, nt_, N_ii, N_jj);
-            
-            LOG(Message) << "All-to-all matrix block "
-            << j/blockSize_ + NBlock_j*i/blockSize_ + 1
-            << "/" << NBlock_i*NBlock_j << " [" << i <<" .. "
-            << i+N_ii-1 << ", " << j <<" .. " << j+N_jj-1 << "]"
-            << std::endl;
-            // Series of cache blocked chunks of the contractions within this block
-            flops    = 0.0;
-            bytes    = 0.0;
-            t_kernel = 0.0;
-            for(int ii=0;ii<N_ii;ii+=cacheBlockSize_)
-            {
-                for(int jj=0;jj<N_jj;jj+=cacheBlockSize_)
-                {
-                    double t;
-                    int N_iii = MIN(N_ii-ii,cacheBlockSize_);
-                    int N_jjj = MIN(N_jj-jj,cacheBlockSize_);
-                    A2AMatrixSet<T> mCacheBlock(mCache_.data(), next_, nstr_, nt_, N_iii, N_jjj);
-                    
-                    START_TIMER("kernel");
-                    // only have the positve vectors
-                    kernel(mCacheBlock, mu, Dns, Umu, &levec[(i+ii)], &revec[(j+jj)], &eval[(j+jj)], orthogDim_, t);
-                    STOP_TIMER("kernel");
-                    t_kernel += t;
-                    flops    += kernel.flops(N_iii, N_jjj);
-                    bytes    += kernel.bytes(N_iii, N_jjj);
-                    
-                    START_TIMER("cache copy");
-                    thread_for_collapse( 5,e,next_,{
-                        for(int s =0;s< nstr_;s++)
-                            for(int t =0;t< nt_;t++)
-                                for(int iii=0;iii< N_iii;iii++)
-                                    for(int jjj=0;jjj< N_jjj;jjj++)
-                                    {
-                                        mBlock(e,s,t,ii+iii,jj+jjj) = mCacheBlock(e,s,t,iii,jjj);
-                                    }
-                    });
-                    STOP_TIMER("cache copy");
-                }
-            }
-            
-            // perf
-            LOG(Message) << "Kernel perf " << flops/t_kernel/1.0e3/nodes
-            << " Gflop/s/node " << std::endl;
-            LOG(Message) << "Kernel perf " << bytes/t_kernel*1.0e6/1024/1024/1024/nodes
-            << " GB/s/node "  << std::endl;
-            
-            // IO
-            double       blockSize, ioTime;
-            unsigned int myRank = grid_->ThisRank(), nRank  = grid_->RankCount();
-            
-            LOG(Message) << "Writing block to disk" << std::endl;
-            ioTime = -GET_TIMER("IO: write block");
-            START_TIMER("IO: total");
-            makeFileDir(filenameFn(0, 0), grid_);
-#ifdef HADRONS_A2AM_PARALLEL_IO
-            grid_->Barrier();
-            // make task list for current node
-            nodeIo_.clear();
-            for(int f = myRank; f < next_*nstr_; f += nRank)
-            {
-                IoHelper h;
-                
-                h.i  = i;
-                h.j  = j;
-                h.e  = f/nstr_;
-                h.s  = f % nstr_;
-                h.io = A2AMatrixIo<TIo>(filenameFn(h.e, h.s),
-                                        ionameFn(h.e, h.s), nt_, N_i, N_j);
-                h.md = metadataFn(h.e, h.s);
-                nodeIo_.push_back(h);
-            }
-            // parallel IO
-            for (auto &h: nodeIo_)
-            {
-                saveBlock(mBlock, h);
-            }
-            grid_->Barrier();
-#else
-            // serial IO, for testing purposes only
-            for(int e = 0; e < next_; e++)
-                for(int s = 0; s < nstr_; s++)
-                {
-                    IoHelper h;
-                    
-                    h.i  = i;
-                    h.j  = j;
-                    h.e  = e;
-                    h.s  = s;
-                    h.io = A2AMatrixIo<TIo>(filenameFn(h.e, h.s),
-                                            ionameFn(h.e, h.s), nt_, N_i, N_j);
-                    h.md = metadataFn(h.e, h.s);
-                    saveBlock(mfBlock, h);
-                }
-#endif
-            STOP_TIMER("IO: total");
-            blockSize  = static_cast<double>(next_*nstr_*nt_*N_ii*N_jj*sizeof(TIo));
-            ioTime    += GET_TIMER("IO: write block");
-            LOG(Message) << "HDF5 IO done " << sizeString(blockSize) << " in "
-            << ioTime  << " us ("
-            << blockSize/ioTime*1.0e6/1024/1024
-            << " MB/s)" << std::endl;
-        }
+    auto call = [this, mu, &Dns, &Umu, &levec, &revec, &eval, &kernel]
+                (A2AMatrixSet<T> &m, const BlockIndex &s, const BlockIndex &c,
+                 double &t)
+    {
+        kernel(m, mu, Dns, Umu, &levec[s[0] + c[0]], &revec[s[1] + c[1]],
+               &eval[s[1] + c[1]], orthogDim_, t);
+    };
+
+    run(BlockIndex{{static_cast<unsigned int>(levec.size()),
+                    static_cast<unsigned int>(revec.size())}},
+        kernel, call, ionameFn, filenameFn, metadataFn);
 }
 
 // I/O handler /////////////////////////////////////////////////////////////////
@@ -1268,6 +1478,139 @@ void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
     STOP_TIMER("IO: write block");
 }
 
+// Blocks are queued until HADRONS_A2AM_IO_BATCH of them are available or the
+// last one is computed, then written together. Without collective I/O each
+// rank writes whole files, otherwise every rank writes a share of the rows of
+// every block of every file.
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixBlockComputation<T, Field, MetadataType, TIo>
+::writeBlock(const A2AMatrixSet<TIo> &mBlock, 
+             const unsigned int i, const unsigned int j,
+             const unsigned int N_i, const unsigned int N_j,
+             const FilenameFn &ionameFn, const FilenameFn &filenameFn,
+             const MetadataFn &metadataFn)
+{
+    typedef typename A2AMatrixIo<TIo>::BlockPos BlockPos;
+
+    double                   blockSize, ioTime;
+    unsigned int             myRank = grid_->ThisRank(), nRank  = grid_->RankCount();
+    unsigned int             N_ii = mBlock.dimension(3), N_jj = mBlock.dimension(4);
+    bool                     last = (i + N_ii >= N_i) and (j + N_jj >= N_j);
+    bool                     first = false;
+    std::vector<const TIo *> data;
+    std::vector<BlockPos>    pos;
+
+    if (HADRONS_A2AM_IO_BATCH > 1)
+    {
+        PendingBlock b;
+
+        b.pos = {i, j, N_ii, N_jj};
+        b.data.resize(mBlock.size());
+        std::copy(mBlock.data(), mBlock.data() + mBlock.size(), b.data.begin());
+        pending_.push_back(std::move(b));
+        if ((pending_.size() < HADRONS_A2AM_IO_BATCH) and !last)
+        {
+            LOG(Message) << "Block queued for writing (" << pending_.size()
+                         << "/" << HADRONS_A2AM_IO_BATCH << ")" << std::endl;
+
+            return;
+        }
+        for (auto &b: pending_)
+        {
+            data.push_back(b.data.data());
+            pos.push_back(b.pos);
+        }
+    }
+    else
+    {
+        data.push_back(mBlock.data());
+        pos.push_back({i, j, N_ii, N_jj});
+    }
+    blockSize = 0.;
+    for (auto &p: pos)
+    {
+        first     = first or ((p.i == 0) and (p.j == 0));
+        blockSize += static_cast<double>(next_*nstr_*nt_*p.ni*p.nj*sizeof(TIo));
+    }
+
+    LOG(Message) << "Writing " << data.size() << " block(s) to disk" << std::endl;
+    ioTime = -GET_TIMER("IO: write block");
+    START_TIMER("IO: total");
+    makeFileDir(filenameFn(0, 0), grid_);
+    grid_->Barrier();
+#ifdef HADRONS_A2AM_COLLECTIVE_IO
+    // file creation, spread over ranks
+    if (first)
+    {
+        START_TIMER("IO: file creation");
+        for(int f = myRank; f < next_*nstr_; f += nRank)
+        {
+            A2AMatrixIo<TIo> io(filenameFn(f/nstr_, f % nstr_), 
+                                ionameFn(f/nstr_, f % nstr_), nt_, N_i, N_j);
+
+            io.initFile(metadataFn(f/nstr_, f % nstr_), blockSize_);
+        }
+        STOP_TIMER("IO: file creation");
+        grid_->Barrier();
+    }
+    // collective IO on every file
+    START_TIMER("IO: write block");
+    for(int f = 0; f < next_*nstr_; f++)
+    {
+        A2AMatrixIo<TIo>         io(filenameFn(f/nstr_, f % nstr_), 
+                                    ionameFn(f/nstr_, f % nstr_), nt_, N_i, N_j);
+        std::vector<const TIo *> fData;
+
+        for (unsigned int b = 0; b < data.size(); ++b)
+        {
+            fData.push_back(data[b] + f*nt_*pos[b].ni*pos[b].nj);
+        }
+        io.saveBlocks(fData, pos, grid_);
+    }
+    STOP_TIMER("IO: write block");
+#else
+    // make task list for current node
+    nodeIo_.clear();
+    for(int f = myRank; f < next_*nstr_; f += nRank)
+    for (unsigned int b = 0; b < data.size(); ++b)
+    {
+        IoHelper h;
+
+        h.i  = pos[b].i;
+        h.j  = pos[b].j;
+        h.e  = f/nstr_;
+        h.s  = f % nstr_;
+        h.io = A2AMatrixIo<TIo>(filenameFn(h.e, h.s), 
+                                ionameFn(h.e, h.s), nt_, N_i, N_j);
+        h.md = metadataFn(h.e, h.s);
+        nodeIo_.push_back(h);
+    }
+    // parallel IO
+    for (auto &h: nodeIo_)
+    {
+        unsigned int b = 0;
+
+        while ((pos[b].i != h.i) or (pos[b].j != h.j))
+        {
+            b++;
+        }
+
+        A2AMatrixSet<TIo> m(const_cast<TIo *>(data[b]), next_, nstr_, nt_, 
+                            pos[b].ni, pos[b].nj);
+
+        saveBlock(m, h);
+    }
+#endif
+    grid_->Barrier();
+    pending_.clear();
+    STOP_TIMER("IO: total");
+    ioTime    += GET_TIMER("IO: write block");
+    LOG(Message) << "HDF5 IO done " << sizeString(blockSize) << " in "
+                 << ioTime  << " us (" 
+                 << blockSize/ioTime*1.0e6/1024/1024
+                 << " MB/s)" << std::endl;
+}
+
 #undef START_TIMER
 #undef STOP_TIMER
 #undef GET_TIMER
@@ -31,6 +31,7 @@ See the full license in the file "LICENSE" in the top level distribution directo
 
 #include <Hadrons/Global.hpp>
 #include <Hadrons/TimerArray.hpp>
+#include <Hadrons/A2ABlockEngine.hpp>
 #include <Grid/Eigen/unsupported/CXX11/Tensor>
 #ifdef USE_MKL
 #include "mkl.h"
@@ -120,10 +121,13 @@ public:
     template <typename MetadataType>
     void initFile(const MetadataType &d, const unsigned int chunkSize);
     // block I/O
+    // t0, nt: time hyperslab held by data (nt = 0 means all time slices)
     void saveBlock(const T *data, const unsigned int str, const unsigned int i, const unsigned int j, const unsigned int k,
-                   const unsigned int blockSizei, const unsigned int blockSizej, const unsigned int blockSizek);
+                   const unsigned int blockSizei, const unsigned int blockSizej, const unsigned int blockSizek,
+                   const unsigned int t0 = 0, const unsigned int nt = 0);
     void saveBlock(const A2AMatrixSetNuc<T> &m, const unsigned int ext, const unsigned int str,
-                   const unsigned int i, const unsigned int j, const unsigned int k);
+                   const unsigned int i, const unsigned int j, const unsigned int k,
+                   const unsigned int t0 = 0);
     template <template <class> class Vec, typename VecT>
     void load(Vec<VecT> &v, double *tRead = nullptr);
     template <template <class> class Vec, typename VecT>
@@ -148,6 +152,33 @@ private:
     };
     typedef std::function<std::string(const unsigned int)>  FilenameFn;
     typedef std::function<MetadataType(const unsigned int)> MetadataFn;
+    typedef typename A2ABlockEngine<3>::Index               BlockIndex;
+    // block engine policy (see A2ABlockEngine.hpp)
+    class BlockPolicy
+    {
+    public:
+        BlockPolicy(A2AMatrixNucleonBlockComputation &c,
+                    const std::vector<Field> &left,
+                    const std::vector<Field> &right,
+                    const std::vector<Field> &q3,
+                    A2AKernelNucleon<T, Field> &kernel,
+                    const FilenameFn &ionameFn, const FilenameFn &filenameFn,
+                    const MetadataFn &metadataFn);
+        void   beginBlock(const BlockIndex &start, const BlockIndex &size);
+        void   kernel(const BlockIndex &start, const BlockIndex &cStart,
+                      const BlockIndex &cSize, double &time);
+        void   copy(const BlockIndex &cStart, const BlockIndex &cSize);
+        double flops(const BlockIndex &cSize);
+        double bytes(const BlockIndex &cSize);
+        void   endBlock(const BlockIndex &start, const BlockIndex &size);
+    private:
+        A2AMatrixNucleonBlockComputation &c_;
+        const std::vector<Field>         &left_, &right_, &q3_;
+        A2AKernelNucleon<T, Field>       &kernel_;
+        const FilenameFn                 &ionameFn_, &filenameFn_;
+        const MetadataFn                 &metadataFn_;
+        BlockIndex                       size_;
+    };
 public:
     // constructor
     A2AMatrixNucleonBlockComputation(GridBase *grid,
@@ -156,7 +187,8 @@ public:
                               const unsigned int nstr,
                               const unsigned int blockSize,
                               const unsigned int cacheBlockSize,
-                              TimerArray *tArray = nullptr);
+                              TimerArray *tArray = nullptr,
+                              const bool distributeTime = false);
     // execution
     void execute(const std::vector<Field> &left, 
                  const std::vector<Field> &right,
@@ -168,10 +200,21 @@ public:
 private:
     // I/O handler
     void saveBlock(const A2AMatrixSetNuc<TIo> &m, IoHelper &h);
+    void writeBlock(const A2AMatrixSetNuc<TIo> &mBlock, const BlockIndex &start,
+                    const BlockIndex &size, const BlockIndex &N,
+                    const FilenameFn &ionameFn, const FilenameFn &filenameFn,
+                    const MetadataFn &metadataFn);
+    void writeDistributedBlock(const A2AMatrixSetNuc<TIo> &m,
+                               const unsigned int i, const unsigned int j, const unsigned int k,
+                               const unsigned int N_i, const unsigned int N_j, const unsigned int N_k,
+                               const FilenameFn &ionameFn, const FilenameFn &filenameFn,
+                               const MetadataFn &metadataFn);
 private:
     TimerArray            *tArray_;
     GridBase              *grid_;
     unsigned int          orthogDim_, nt_, next_, nstr_, blockSize_, cacheBlockSize_;
+    bool                  distributeTime_;
+    unsigned int          localNt_, tFirst_;
     Vector<T>             mCache_;
     Vector<TIo>           mBuf_;
     std::vector<IoHelper> nodeIo_;
@@ -183,53 +226,60 @@ private:
 class A2AContractionNucleon
 {
 public:
-	// function to contract two rank 4 A2A nucleon fields into a spin matrix
-	// spinMat_(mu,nu) = a_(ijk,mu)*b(ijk,nu)
-	template <typename Mat, typename TenLeft, typename TenRight>
-	static inline void contNucTen(Mat &spinMat, const TenLeft &a, const TenRight &b)
+	// antiSymNucTen(res, a): res(mu,i,j,k) = a(mu,i,j,k) - a(mu,k,j,i)
+	// (the k<->i exchange term of the nucleon contractions, folded into a copy)
+	template <typename TenRes, typename Ten>
+	static inline void antiSymNucTen(TenRes &res, const Ten &a)
 	{
-		//std::cout << "DEBUG: Nucleon contraction 1 started" << std::endl;
+		const Eigen::Index nMu = a.dimension(0), nI = a.dimension(1),
+		                   nJ  = a.dimension(2), nK = a.dimension(3);
 
-		Eigen::Index nRow_mu, nRow_nu, nRow_i, nRow_j, nRow_k;
-		
-		// Make sure spinMat is a square matrix
-		if ((a.dimension(0) != b.dimension(0)) or (spinMat.rows() != spinMat.cols()) or (a.dimension(0) != spinMat.rows()))
-		{
-			// error here -- dimensions mismatch
-		}
-		else
+		if (nI != nK)
 		{
-			nRow_mu = a.dimension(0);
-			nRow_nu = b.dimension(0);
+			HADRONS_ERROR(Size, "nucleon tensor i and k dimensions mismatch");
 		}
-		
-		// Make sure a and b dimensions match
-		if ((a.dimension(1) != b.dimension(1)) or (a.dimension(2) != b.dimension(2)) or (a.dimension(3) != b.dimension(3)))
+		res.resize(nMu, nI, nJ, nK);
+		thread_for(ij, nMu*nI*nJ,
 		{
-			// error here -- index dimensions mismatch
-		}
-		else
+			const Eigen::Index mu = ij/(nI*nJ), i = (ij/nJ)%nI, j = ij%nJ;
+
+			for (Eigen::Index k = 0; k < nK; k++)
+			{
+				res(mu, i, j, k) = a(mu, i, j, k) - a(mu, k, j, i);
+			}
+		});
+	}
+
+	// function to contract two rank 4 A2A nucleon fields into a spin matrix
+	// spinMat_(mu,nu) += a_(ijk,mu)*conj(bAsym(ijk,nu)), with bAsym already
+	// antisymmetrised by antiSymNucTen. This is a single (Ns x ijk)*(ijk x Ns)
+	// GEMM over the flattened ijk index.
+	template <typename Mat, typename TenLeft, typename TenRight>
+	static inline void contNucTenAsym(Mat &spinMat, const TenLeft &a, const TenRight &bAsym)
+	{
+		static_assert((static_cast<int>(TenLeft::Layout) == Eigen::RowMajor) and
+		              (static_cast<int>(TenRight::Layout) == Eigen::RowMajor),
+		              "nucleon tensors must be row-major");
+
+		const Eigen::Index nMu = a.dimension(0), nNu = bAsym.dimension(0);
+		const Eigen::Index n   = a.size()/nMu;
+
+		if ((bAsym.size()/nNu != n) or (spinMat.rows() != nMu) or (spinMat.cols() != nNu))
 		{
-			nRow_i = a.dimension(1);
-			nRow_j = a.dimension(2);
-			nRow_k = a.dimension(3);
+			HADRONS_ERROR(Size, "nucleon tensor contraction dimensions mismatch");
 		}
-		
-	       // MCA - very basic parallelization for now
-               thread_for(mu, Ns, {
-                   for(int nu=0; nu < Ns; nu++)
-                      for (int i = 0; i < nRow_i; i++)
-                        for (int j = 0; j < nRow_j; j++)
-                          for (int k = 0; k < nRow_k; k++)
-                             {
-                                //ComplexD tmp;
-                                //tmp = a(mu,i,j,k) * (std::conj(b(nu,i,j,k)) - std::conj(b(nu,k,j,i)));
-                                //ComplexD tmp2(b(nu,i,j,k).real()-b(nu,k,j,i).real(),b(nu,k,j,i).imag()-b(nu,i,j,k).imag());
-                                //tmp = a(mu,i,j,k) * tmp2;
-                                //spinMat(mu,nu) += tmp;
-                                spinMat(mu,nu) += a(mu,i,j,k) * (std::conj(b(nu,i,j,k)) - std::conj(b(nu,k,j,i)));
-                             }
-               });
+		gemmNucAdj(spinMat, a.data(), bAsym.data(), nMu, nNu, n);
+	}
+
+	// function to contract two rank 4 A2A nucleon fields into a spin matrix
+	// spinMat_(mu,nu) = a_(ijk,mu)*b(ijk,nu)
+	template <typename Mat, typename TenLeft, typename TenRight>
+	static inline void contNucTen(Mat &spinMat, const TenLeft &a, const TenRight &b)
+	{
+		A2AMatrixNuc<typename TenRight::Scalar> bAsym;
+
+		antiSymNucTen(bAsym, b);
+		contNucTenAsym(spinMat, a, bAsym);
 	}
 
 	static void contNucTenTest()
@@ -289,64 +339,34 @@ public:
 	}
 
 	// function to contract two rank 4 A2A nucleon fields and a rank 2 meson field into a spin matrix
-	// spinMat_(mu,nu) = a_(ijk,mu)*c(jm)*b(imk,nu)
+	// spinMat_(mu,nu) = a_(ijk,mu)*c(km)*b(ijm,nu) with both tensors antisymmetrised
+	// in i<->k, i.e. (a(ijk) - a(kji))*c(km)*conj(b(ijm) - b(mji)). Computed as two
+	// GEMMs: ac(mu ij, m) = aAsym(mu ij, k)*c(k, m), then ac*bAsym^dagger over ijm.
 	template <typename Mat, typename TenLeft, typename MatMid, typename TenRight>
 	static inline void contNuc3ptUp(Mat &spinMat, const TenLeft &a, const MatMid &c, const TenRight &b)
 	{
+		typedef typename TenLeft::Scalar T;
 
-		Eigen::Index nRow_mu, nRow_nu, nRow_i, nRow_j, nRow_k, nRow_m;
-		
-		// Make sure spinMat is a square matrix
-		if ((a.dimension(0) != b.dimension(0)) or (spinMat.rows() != spinMat.cols()) or (a.dimension(0) != spinMat.rows()))
-		{
-			// error here -- dimensions mismatch
-		}
-		else
-		{
-			nRow_mu = a.dimension(0);
-			nRow_nu = b.dimension(0);
-		}
-		
-		// Make sure a and b dimensions match
-		if ((a.dimension(1) != b.dimension(1)) or (a.dimension(2) != b.dimension(2)) or (a.dimension(3) != b.dimension(3)))
-		{
-			// error here -- index dimensions mismatch
-		}
-		else
-		{
-			nRow_i = a.dimension(1);
-			nRow_j = a.dimension(2);
-			nRow_k = a.dimension(3);
-		}
-		
-		// Make sure c is a square matrix
-		if ((c.rows() != c.cols()) or (c.rows() != nRow_i))
+		A2AMatrixNuc<T>                           aAsym, ac;
+		A2AMatrixNuc<typename TenRight::Scalar>   bAsym;
+		const A2AMatrix<T>                        cRow = c;
+
+		if ((c.rows() != c.cols()) or (c.rows() != a.dimension(3)) or (a.dimension(3) != b.dimension(3)))
 		{
-			// error here -- dimensions mismatch
+			HADRONS_ERROR(Size, "nucleon 3-point contraction dimensions mismatch");
 		}
-		else
+		antiSymNucTen(aAsym, a);
+		antiSymNucTen(bAsym, b);
+		ac.resize(aAsym.dimension(0), aAsym.dimension(1), aAsym.dimension(2), cRow.cols());
 		{
-			nRow_m = c.rows();
+			const Eigen::Index rows = aAsym.size()/aAsym.dimension(3);
+
+			Eigen::Map<const A2AMatrix<T>> aMap(aAsym.data(), rows, aAsym.dimension(3));
+			Eigen::Map<A2AMatrix<T>>       acMap(ac.data(), rows, cRow.cols());
+
+			acMap.noalias() = aMap*cRow;
 		}
-		
-		// MCA - very basic parallelization for now
-                thread_for(mu,Ns,{
-                       thread_for(nu,Ns,{
-                                for (int i = 0; i < nRow_i; i++)
-                                for (int j = 0; j < nRow_j; j++)
-                                for (int k = 0; k < nRow_k; k++)
-                                for (int m = 0; m < nRow_m; m++)
-                                {
-                                        ComplexD tmp;
-                                        tmp = a(mu,i,j,k) * c(k,m) * std::conj(b(nu,i,j,m))
-                                                        - a(mu,i,j,k) * c(k,m) * std::conj(b(nu,m,j,i))
-                                                        + a(mu,k,j,i) * c(k,m) * std::conj(b(nu,m,j,i))
-                                                        - a(mu,k,j,i) * c(k,m) * std::conj(b(nu,i,j,m));
-                                        spinMat(mu,nu) += tmp;
-
-                                }
-                        });
-                });
+		contNucTenAsym(spinMat, ac, bAsym);
 	}
 
 	static void contNuc3ptUpTest()
@@ -620,13 +640,12 @@ public:
         }
     }
 
-	// MCA - TO DO
 	template <typename TenLeft, typename TenRight>
 	static inline double contNucTenFlops(const TenLeft &a, const TenRight &b)
 	{
-		// Add flops data here
-		
-		return 0.;
+		double n = a.size()/a.dimension(0);
+
+		return 8.*a.dimension(0)*b.dimension(0)*n;
 	}
 
     template <typename MatLeft, typename MatRight>
@@ -637,6 +656,43 @@ public:
         return 8.*n;
     }
 
+    // gemmNucAdj(res, a, b, m, n, k): res += a*b^dagger, with a (m x k) and
+    // b (n x k) contiguous row-major buffers and res an Eigen matrix
+#ifdef USE_MKL
+    template <typename Mat>
+    static inline void gemmNucAdj(Mat &res, const ComplexD *a, const ComplexD *b,
+                                  const int m, const int n, const int k)
+    {
+        static const ComplexD one(1., 0.);
+        A2AMatrix<ComplexD>   tmp = res;
+
+        cblas_zgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, m, n, k, &one,
+                    a, k, b, k, &one, tmp.data(), n);
+        res = tmp;
+    }
+
+    template <typename Mat>
+    static inline void gemmNucAdj(Mat &res, const ComplexF *a, const ComplexF *b,
+                                  const int m, const int n, const int k)
+    {
+        static const ComplexF one(1., 0.);
+        A2AMatrix<ComplexF>   tmp = res.template cast<ComplexF>();
+
+        cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, m, n, k, &one,
+                    a, k, b, k, &one, tmp.data(), n);
+        res = tmp.template cast<typename Mat::Scalar>();
+    }
+#else
+    template <typename Mat, typename T>
+    static inline void gemmNucAdj(Mat &res, const T *a, const T *b,
+                                  const int m, const int n, const int k)
+    {
+        Eigen::Map<const A2AMatrix<T>> aMap(a, m, k), bMap(b, n, k);
+
+        res += (aMap*bMap.adjoint()).template cast<typename Mat::Scalar>();
+    }
+#endif
+
     // mul(res, a, b): res = a*b
 #ifdef USE_MKL
     template <template <class, int...> class Mat, int... Opts>
@@ -900,12 +956,14 @@ void A2AMatrixNucIo<T>::saveBlock(const T *data,
                                const unsigned int k,
                                const unsigned int blockSizei,
                                const unsigned int blockSizej,
-                               const unsigned int blockSizek)
+                               const unsigned int blockSizek,
+                               const unsigned int t0,
+                               const unsigned int nt)
 {
 #ifdef HAVE_HDF5
     Hdf5Reader           reader(filename_, false);
-    std::vector<hsize_t> count = {nt_, Ns, blockSizei, blockSizej, blockSizek},
-                         offset = {0, static_cast<hsize_t>(str), static_cast<hsize_t>(i),
+    std::vector<hsize_t> count = {(nt == 0) ? nt_ : nt, Ns, blockSizei, blockSizej, blockSizek},
+                         offset = {static_cast<hsize_t>(t0), static_cast<hsize_t>(str), static_cast<hsize_t>(i),
                                    static_cast<hsize_t>(j),
                                    static_cast<hsize_t>(k)},
                          stride = {1, 1, 1, 1, 1},
@@ -929,17 +987,18 @@ void A2AMatrixNucIo<T>::saveBlock(const T *data,
 template <typename T>
 void A2AMatrixNucIo<T>::saveBlock(const A2AMatrixSetNuc<T> &m,
                                const unsigned int ext, const unsigned int str,
-                               const unsigned int i, const unsigned int j, const unsigned int k)
+                               const unsigned int i, const unsigned int j, const unsigned int k,
+                               const unsigned int t0)
 {
+    // m dimensions are (ext, t, str, i, j, k), all spins are written at once
     unsigned int blockSizei = m.dimension(3);
     unsigned int blockSizej = m.dimension(4);
     unsigned int blockSizek = m.dimension(5);
-    unsigned int nstr       = m.dimension(1);
-    size_t       offset     = (ext*nstr + str)*nt_*blockSizei*blockSizej*blockSizek;
+    unsigned int nt         = m.dimension(1);
+    unsigned int nstr       = m.dimension(2);
+    size_t       offset     = ext*nt*nstr*blockSizei*blockSizej*blockSizek;
 
-	std::cout << "Still working inside NucIo::saveBlock with external " << std::to_string(ext) << " and spin " << std::to_string(str)
-				<< " and offset " << std::to_string(offset) << std::endl;
-    saveBlock(m.data() + offset, str, i, j, k, blockSizei, blockSizej, blockSizek);
+    saveBlock(m.data() + offset, str, i, j, k, blockSizei, blockSizej, blockSizek, t0, nt);
 }
 
 template <typename T>
@@ -1265,13 +1324,26 @@ A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>
                             const unsigned int nstr,
                             const unsigned int blockSize, 
                             const unsigned int cacheBlockSize,
-                            TimerArray *tArray)
+                            TimerArray *tArray,
+                            const bool distributeTime)
 : grid_(grid), nt_(grid->GlobalDimensions()[orthogDim]), orthogDim_(orthogDim)
 , next_(next), nstr_(nstr), blockSize_(blockSize), cacheBlockSize_(cacheBlockSize)
-, tArray_(tArray)
+, tArray_(tArray), distributeTime_(distributeTime)
 {
+    // in time-distributed mode each rank only keeps (and writes) the block
+    // entries for its local time slices
+    if (distributeTime_)
+    {
+        localNt_ = grid_->LocalDimensions()[orthogDim_];
+        tFirst_  = grid_->LocalStarts()[orthogDim_];
+    }
+    else
+    {
+        localNt_ = nt_;
+        tFirst_  = 0;
+    }
     mCache_.resize(nt_*next_*nstr_*cacheBlockSize_*cacheBlockSize_*cacheBlockSize_);
-    mBuf_.resize(nt_*next_*nstr_*blockSize_*blockSize_*blockSize_);
+    mBuf_.resize(localNt_*next_*nstr_*blockSize_*blockSize_*blockSize_);
 }
 
 #define START_TIMER(name) if (tArray_) tArray_->startTimer(name)
@@ -1285,89 +1357,121 @@ void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>
           A2AKernelNucleon<T, Field> &kernel, const FilenameFn &ionameFn,
           const FilenameFn &filenameFn, const MetadataFn &metadataFn)
 {
-    //////////////////////////////////////////////////////////////////////////
-    // i,j,k   is first  loop over blockSize_ factors
-    // ii,jj,kk is second loop over cacheBlockSize_ factors for high perf contractions
-    // iii,jjj,kkk are loops within cacheBlock
-    // Total index is sum of these  i+ii+iii etc...
-    //////////////////////////////////////////////////////////////////////////
-    int    N_i = left.size();
-    int    N_j = right.size();
-    int    N_k = q3.size();
-    double flops, bytes, t_kernel;
-    double nodes = grid_->NodeCount();
-    
-    int NBlock_i = N_i/blockSize_ + (((N_i % blockSize_) != 0) ? 1 : 0);
-    int NBlock_j = N_j/blockSize_ + (((N_j % blockSize_) != 0) ? 1 : 0);
-    int NBlock_k = N_k/blockSize_ + (((N_k % blockSize_) != 0) ? 1 : 0);
+    A2ABlockEngine<3> engine(grid_, blockSize_, cacheBlockSize_, tArray_);
+    BlockPolicy       policy(*this, left, right, q3, kernel,
+                             ionameFn, filenameFn, metadataFn);
 
-    for(int i=0;i<N_i;i+=blockSize_)
-    for(int j=0;j<N_j;j+=blockSize_)
-    for(int k=0;k<N_k;k+=blockSize_)
-    {
-        // Get the W and V vectors for this block^3 set of terms
-        int N_ii = MIN(N_i-i,blockSize_);
-        int N_jj = MIN(N_j-j,blockSize_);
-        int N_kk = MIN(N_k-k,blockSize_);
-        // MCA - need to change this function to tensor from matrix???
-        A2AMatrixSetNuc<TIo> mBlock(mBuf_.data(), next_, nt_, nstr_, N_ii, N_jj, N_kk);
-
-        LOG(Message) << "All-to-all matrix block " 
-                     << k/blockSize_ + NBlock_k*j/blockSize_ + NBlock_k*NBlock_j*i/blockSize_ + 1 
-                     << "/" << NBlock_i*NBlock_j*NBlock_k << " [" << i <<" .. " 
-                     << i+N_ii-1 << ", " << j <<" .. " << j+N_jj-1 << ", "
-                     << k << " .. " << k+N_kk-1 <<"]" 
-                     << std::endl;
-        // Series of cache blocked chunks of the contractions within this block
-        flops    = 0.0;
-        bytes    = 0.0;
-        t_kernel = 0.0;
-        for(int ii=0;ii<N_ii;ii+=cacheBlockSize_)
-        for(int jj=0;jj<N_jj;jj+=cacheBlockSize_)
-        for(int kk=0;kk<N_kk;kk+=cacheBlockSize_)
-        {
-            double t;
-            int N_iii = MIN(N_ii-ii,cacheBlockSize_);
-            int N_jjj = MIN(N_jj-jj,cacheBlockSize_);
-            int N_kkk = MIN(N_kk-kk,cacheBlockSize_);
-            // MCA - need to change this function too
-            A2AMatrixSetNuc<T> mCacheBlock(mCache_.data(), next_, nstr_, nt_, N_iii, N_jjj, N_kkk);
-
-            START_TIMER("kernel");
-            kernel(mCacheBlock, &left[i+ii], &right[j+jj], &q3[k+kk], orthogDim_, t);
-            STOP_TIMER("kernel");
-            t_kernel += t;
-            flops    += kernel.flops(N_iii, N_jjj, N_kkk);
-            bytes    += kernel.bytes(N_iii, N_jjj, N_kkk);
-
-            START_TIMER("cache copy");
-            thread_for_collapse(6, e, next_, {
-                for(int s=0;s< nstr_;s++)
-                    for(int t=0;t< nt_;t++)
-                        for(int iii=0;iii< N_iii;iii++)
-                            for(int jjj=0;jjj< N_jjj;jjj++)
-                                for(int kkk=0;kkk< N_kkk;kkk++){
-                                    mBlock(e,t,s,ii+iii,jj+jjj,kk+kkk) = mCacheBlock(e,s,t,iii,jjj,kkk);
-                                }
-            });
-            STOP_TIMER("cache copy");
-        }
+    engine.run(BlockIndex{{static_cast<unsigned int>(left.size()),
+                           static_cast<unsigned int>(right.size()),
+                           static_cast<unsigned int>(q3.size())}}, policy);
+}
 
-	LOG(Message) << "t | i | j | k | mu Value" << std::endl;
-        // perf
-        LOG(Message) << "Kernel perf " << flops/t_kernel/1.0e3/nodes 
-                     << " Gflop/s/node " << std::endl;
-        LOG(Message) << "Kernel perf " << bytes/t_kernel*1.0e6/1024/1024/1024/nodes 
-                     << " GB/s/node "  << std::endl;
+// block engine policy /////////////////////////////////////////////////////////
+template <typename T, typename Field, typename MetadataType, typename TIo>
+A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>::BlockPolicy
+::BlockPolicy(A2AMatrixNucleonBlockComputation &c, const std::vector<Field> &left,
+              const std::vector<Field> &right, const std::vector<Field> &q3,
+              A2AKernelNucleon<T, Field> &kernel, const FilenameFn &ionameFn,
+              const FilenameFn &filenameFn, const MetadataFn &metadataFn)
+: c_(c), left_(left), right_(right), q3_(q3), kernel_(kernel)
+, ionameFn_(ionameFn), filenameFn_(filenameFn), metadataFn_(metadataFn)
+{}
 
-        // IO
-        double       blockSize, ioTime;
-        unsigned int myRank = grid_->ThisRank(), nRank  = grid_->RankCount();
-    
-        LOG(Message) << "Writing block to disk" << std::endl;
-        ioTime = -GET_TIMER("IO: write block");
-        START_TIMER("IO: total");
-        makeFileDir(filenameFn(0), grid_);
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>::BlockPolicy
+::beginBlock(const BlockIndex &start, const BlockIndex &size)
+{
+    size_ = size;
+}
+
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>::BlockPolicy
+::kernel(const BlockIndex &start, const BlockIndex &cStart,
+         const BlockIndex &cSize, double &time)
+{
+    A2AMatrixSetNuc<T> mCacheBlock(c_.mCache_.data(), c_.next_, c_.nstr_, c_.nt_,
+                                   cSize[0], cSize[1], cSize[2]);
+
+    kernel_(mCacheBlock, &left_[start[0] + cStart[0]], &right_[start[1] + cStart[1]],
+            &q3_[start[2] + cStart[2]], c_.orthogDim_, time);
+}
+
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>::BlockPolicy
+::copy(const BlockIndex &cStart, const BlockIndex &cSize)
+{
+    const int next = c_.next_, nstr = c_.nstr_, nt = c_.nt_;
+    const int localNt = c_.localNt_, tFirst = c_.tFirst_;
+    const int ii = cStart[0], jj = cStart[1], kk = cStart[2];
+    const int N_iii = cSize[0], N_jjj = cSize[1], N_kkk = cSize[2];
+    A2AMatrixSetNuc<T>   mCacheBlock(c_.mCache_.data(), next, nstr, nt, 
+                                     N_iii, N_jjj, N_kkk);
+    A2AMatrixSetNuc<TIo> mBlock(c_.mBuf_.data(), next, localNt, nstr, 
+                                size_[0], size_[1], size_[2]);
+
+    thread_for_collapse(6, e, next, {
+        for(int s=0;s< nstr;s++)
+            for(int t=0;t< localNt;t++)
+                for(int iii=0;iii< N_iii;iii++)
+                    for(int jjj=0;jjj< N_jjj;jjj++)
+                        for(int kkk=0;kkk< N_kkk;kkk++){
+                            mBlock(e,t,s,ii+iii,jj+jjj,kk+kkk) = mCacheBlock(e,s,tFirst+t,iii,jjj,kkk);
+                        }
+    });
+}
+
+template <typename T, typename Field, typename MetadataType, typename TIo>
+double A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>::BlockPolicy
+::flops(const BlockIndex &cSize)
+{
+    return kernel_.flops(cSize[0], cSize[1], cSize[2]);
+}
+
+template <typename T, typename Field, typename MetadataType, typename TIo>
+double A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>::BlockPolicy
+::bytes(const BlockIndex &cSize)
+{
+    return kernel_.bytes(cSize[0], cSize[1], cSize[2]);
+}
+
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>::BlockPolicy
+::endBlock(const BlockIndex &start, const BlockIndex &size)
+{
+    A2AMatrixSetNuc<TIo> mBlock(c_.mBuf_.data(), c_.next_, c_.localNt_, c_.nstr_,
+                                size[0], size[1], size[2]);
+
+    c_.writeBlock(mBlock, start, size, 
+                  BlockIndex{{static_cast<unsigned int>(left_.size()),
+                              static_cast<unsigned int>(right_.size()),
+                              static_cast<unsigned int>(q3_.size())}},
+                  ionameFn_, filenameFn_, metadataFn_);
+}
+
+// block write /////////////////////////////////////////////////////////////////
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>
+::writeBlock(const A2AMatrixSetNuc<TIo> &mBlock, const BlockIndex &start,
+             const BlockIndex &size, const BlockIndex &N,
+             const FilenameFn &ionameFn, const FilenameFn &filenameFn,
+             const MetadataFn &metadataFn)
+{
+    const unsigned int i = start[0], j = start[1], k = start[2];
+    const unsigned int N_i = N[0], N_j = N[1], N_k = N[2];
+    double             blockSize, ioTime;
+    unsigned int       myRank = grid_->ThisRank(), nRank  = grid_->RankCount();
+
+    LOG(Message) << "Writing block to disk" << std::endl;
+    ioTime = -GET_TIMER("IO: write block");
+    START_TIMER("IO: total");
+    makeFileDir(filenameFn(0), grid_);
+    if (distributeTime_)
+    {
+        writeDistributedBlock(mBlock, i, j, k, N_i, N_j, N_k,
+                              ionameFn, filenameFn, metadataFn);
+    }
+    else
+    {
 #ifdef HADRONS_A2AN_PARALLEL_IO
         grid_->Barrier();
         // make task list for current node
@@ -1382,22 +1486,19 @@ void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>
             h.e  = f/nstr_;
             h.s  = 0;
             h.io = A2AMatrixNucIo<TIo>(filenameFn(h.e), 
-                                    ionameFn(h.e), nt_, N_i, N_j, N_k);
+                                       ionameFn(h.e), nt_, N_i, N_j, N_k);
             h.md = metadataFn(h.e);
             nodeIo_.push_back(h);
         }
-        std::cout << "Still working" << std::endl;
         // parallel IO
         for (auto &h: nodeIo_)
         {
             saveBlock(mBlock, h);
         }
         grid_->Barrier();
-        std::cout << "Still working after saveBlock" << std::endl;
 #else
         // serial IO, for testing purposes only
         for(int e = 0; e < next_; e++)
-        //for(int s = 0; s < nstr_; s++)
         {
             IoHelper h;
 
@@ -1407,19 +1508,19 @@ void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>
             h.e  = e;
             h.s  = 0;
             h.io = A2AMatrixNucIo<TIo>(filenameFn(h.e), 
-                                    ionameFn(h.e), nt_, N_i, N_j, N_k);
+                                       ionameFn(h.e), nt_, N_i, N_j, N_k);
             h.md = metadataFn(h.e);
             saveBlock(mBlock, h);
         }
 #endif
-        STOP_TIMER("IO: total");
-        blockSize  = static_cast<double>(next_*nt_*nstr_*N_ii*N_jj*N_kk*sizeof(TIo));
-        ioTime    += GET_TIMER("IO: write block");
-        LOG(Message) << "HDF5 IO done " << sizeString(blockSize) << " in "
-                     << ioTime  << " us (" 
-                     << blockSize/ioTime*1.0e6/1024/1024
-                     << " MB/s)" << std::endl;
     }
+    STOP_TIMER("IO: total");
+    blockSize  = static_cast<double>(next_*localNt_*nstr_*size[0]*size[1]*size[2]*sizeof(TIo));
+    ioTime    += GET_TIMER("IO: write block");
+    LOG(Message) << "HDF5 IO done " << sizeString(blockSize) << " in "
+                 << ioTime  << " us (" 
+                 << blockSize/ioTime*1.0e6/1024/1024
+                 << " MB/s)" << std::endl;
 }
 
 // I/O handler /////////////////////////////////////////////////////////////////
@@ -1438,6 +1539,60 @@ void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>
     STOP_TIMER("IO: write block");
 }
 
+// time-distributed block write ////////////////////////////////////////////////
+// Each time slab is written by the rank of its slab with zero coordinates in
+// the other directions. HDF5 is used serially, so slab writers take turns on
+// the files with a barrier in between; the file is created by rank 0 first.
+template <typename T, typename Field, typename MetadataType, typename TIo>
+void A2AMatrixNucleonBlockComputation<T, Field, MetadataType, TIo>
+::writeDistributedBlock(const A2AMatrixSetNuc<TIo> &m,
+                        const unsigned int i, const unsigned int j, const unsigned int k,
+                        const unsigned int N_i, const unsigned int N_j, const unsigned int N_k,
+                        const FilenameFn &ionameFn, const FilenameFn &filenameFn,
+                        const MetadataFn &metadataFn)
+{
+    const int nSlab     = grid_->_processors[orthogDim_];
+    const int mySlab    = grid_->_processor_coor[orthogDim_];
+    bool      slabOwner = true;
+
+    for (unsigned int mu = 0; mu < grid_->_ndimension; ++mu)
+    {
+        if ((mu != orthogDim_) and (grid_->_processor_coor[mu] != 0))
+        {
+            slabOwner = false;
+        }
+    }
+    for (unsigned int e = 0; e < next_; ++e)
+    {
+        IoHelper h;
+
+        h.i  = i;
+        h.j  = j;
+        h.k  = k;
+        h.e  = e;
+        h.s  = 0;
+        h.io = A2AMatrixNucIo<TIo>(filenameFn(h.e), ionameFn(h.e), nt_, N_i, N_j, N_k);
+        h.md = metadataFn(h.e);
+        if ((i == 0) and (j == 0) and (k == 0) and grid_->IsBoss())
+        {
+            START_TIMER("IO: file creation");
+            h.io.initFile(h.md, blockSize_);
+            STOP_TIMER("IO: file creation");
+        }
+        grid_->Barrier();
+        for (int slab = 0; slab < nSlab; ++slab)
+        {
+            if (slabOwner and (slab == mySlab))
+            {
+                START_TIMER("IO: write block");
+                h.io.saveBlock(m, h.e, h.s, h.i, h.j, h.k, tFirst_);
+                STOP_TIMER("IO: write block");
+            }
+            grid_->Barrier();
+        }
+    }
+}
+
 #undef START_TIMER
 #undef STOP_TIMER
 #undef GET_TIMER
@@ -54,6 +54,11 @@ public:
                       const FermionField &evec, const Real &eval);
     void makeLowModeW5D(FermionField &wout_4d, FermionField &wout_5d, 
                         const FermionField &evec, const Real &eval);
+    void makeLowModeVW(FermionField &vout, FermionField &wout,
+                       const FermionField &evec, const Real &eval);
+    void makeLowModeVW5D(FermionField &vout_4d, FermionField &wout_4d,
+                         FermionField &f_5d, const FermionField &evec, 
+                         const Real &eval);
     void makeHighModeV(FermionField &vout, const FermionField &noise);
     void makeHighModeV5D(FermionField &vout_4d, FermionField &vout_5d, 
                          const FermionField &noise_5d);
@@ -284,6 +289,60 @@ void A2AVectorsSchurDiagTwo<FImpl>::makeLowModeW5D(FermionField &wout_4d,
     action_.ExportPhysicalFermionSource(wout_5d, wout_4d);
 }
 
+// V & W low modes from the same eigenvector, sharing the operator applications
+// that makeLowModeV and makeLowModeW would both perform
+template <typename FImpl>
+void A2AVectorsSchurDiagTwo<FImpl>::makeLowModeVW(FermionField &vout, 
+                                                  FermionField &wout, 
+                                                  const FermionField &evec, 
+                                                  const Real &eval)
+{
+    src_o_ = evec;
+    src_o_.Checkerboard() = Odd;
+
+    /////////////////////////////////////////////////////
+    // v_io = (1/eval_i) * MooInv evec_i
+    // v_ie = - MeeInv Meo v_io
+    /////////////////////////////////////////////////////
+    action_.MooeeInv(src_o_, tmp_);
+    assert(tmp_.Checkerboard() == Odd);
+    sol_o_ = (1.0 / eval) * tmp_;
+    action_.Meooe(sol_o_, sol_e_);
+    assert(sol_e_.Checkerboard() == Even);
+    action_.MooeeInv(sol_e_, tmp_);
+    assert(tmp_.Checkerboard() == Even);
+    sol_e_ = (-1.0) * tmp_;
+    setCheckerboard(vout, sol_e_);
+    setCheckerboard(vout, sol_o_);
+
+    /////////////////////////////////////////////////////
+    // w_io = Doo evec_i
+    // w_ie = - MeeInvDag MoeDag w_io
+    /////////////////////////////////////////////////////
+    op_.Mpc(src_o_, sol_o_);
+    assert(sol_o_.Checkerboard() == Odd);
+    action_.MeooeDag(sol_o_, sol_e_);
+    assert(sol_e_.Checkerboard() == Even);
+    action_.MooeeInvDag(sol_e_, tmp_);
+    assert(tmp_.Checkerboard() == Even);
+    sol_e_ = (-1.0) * tmp_;
+    setCheckerboard(wout, sol_e_);
+    setCheckerboard(wout, sol_o_);
+}
+
+template <typename FImpl>
+void A2AVectorsSchurDiagTwo<FImpl>::makeLowModeVW5D(FermionField &vout_4d, 
+                                                    FermionField &wout_4d,
+                                                    FermionField &f_5d,
+                                                    const FermionField &evec, 
+                                                    const Real &eval)
+{
+    makeLowModeVW(f_5d, tmp5_, evec, eval);
+    action_.ExportPhysicalFermionSolution(f_5d, vout_4d);
+    action_.DminusDag(tmp5_, f_5d);
+    action_.ExportPhysicalFermionSource(f_5d, wout_4d);
+}
+
 template <typename FImpl>
 void A2AVectorsSchurDiagTwo<FImpl>::makeHighModeV(FermionField &vout, 
                                                   const FermionField &noise)
@@ -35,6 +35,75 @@
 
 BEGIN_HADRONS_NAMESPACE
 
+/******************************************************************************
+ *              Counter-based Z2xZ2 noise (Philox-4x32-10)                    *
+ ******************************************************************************/
+// Philox-4x32-10 block cipher (Salmon et al., SC'11), applied in place to ctr.
+inline void philox4x32(uint32_t ctr[4], const uint32_t key[2])
+{
+    const uint64_t m0 = 0xD2511F53, m1 = 0xCD9E8D57;
+    uint32_t       k0 = key[0], k1 = key[1];
+
+    for (unsigned int r = 0; r < 10; ++r)
+    {
+        const uint64_t p0 = m0*ctr[0], p1 = m1*ctr[2];
+        const uint32_t c1 = ctr[1], c3 = ctr[3];
+
+        ctr[0] = static_cast<uint32_t>(p1 >> 32)^c1^k0;
+        ctr[1] = static_cast<uint32_t>(p1);
+        ctr[2] = static_cast<uint32_t>(p0 >> 32)^c3^k1;
+        ctr[3] = static_cast<uint32_t>(p0);
+        k0    += 0x9E3779B9;
+        k1    += 0xBB67AE85;
+    }
+}
+
+// Fill eta with (+-1 +- i)/sqrt(2) noise. Every site value is a pure function
+// of (seed, hit, global site index), so a hit can be regenerated on demand
+// instead of being stored, and the result does not depend on the MPI layout.
+inline void counterNoise(LatticeComplex &eta, const uint64_t seed,
+                         const uint32_t hit)
+{
+    typedef typename LatticeComplex::scalar_object sobj;
+
+    GridBase       *grid = eta.Grid();
+    const int      nd    = grid->Nd();
+    const int      Nsimd = grid->Nsimd();
+    const Real     norm  = 1./::sqrt(2.);
+    const uint32_t key[2] = {static_cast<uint32_t>(seed),
+                             static_cast<uint32_t>(seed >> 32)};
+
+    autoView(eta_v, eta, CpuWrite);
+    thread_for(osite, grid->oSites(),
+    {
+        ExtractBuffer<sobj> buf(Nsimd);
+        Coordinate          ocoor(nd), icoor(nd);
+
+        grid->oCoorFromOindex(ocoor, osite);
+        for (int lane = 0; lane < Nsimd; ++lane)
+        {
+            uint64_t gsite = 0;
+
+            grid->iCoorFromIindex(icoor, lane);
+            for (int d = nd - 1; d >= 0; --d)
+            {
+                const int gcoor = grid->_processor_coor[d]*grid->_ldimensions[d]
+                                  + ocoor[d] + grid->_rdimensions[d]*icoor[d];
+
+                gsite = gsite*grid->_fdimensions[d] + gcoor;
+            }
+
+            uint32_t ctr[4] = {static_cast<uint32_t>(gsite),
+                               static_cast<uint32_t>(gsite >> 32), hit, 0};
+
+            philox4x32(ctr, key);
+            buf[lane]()()() = Complex((ctr[0] >> 31) ? norm : -norm,
+                                      (ctr[1] >> 31) ? norm : -norm);
+        }
+        merge(eta_v[osite], buf);
+    });
+}
+
 /******************************************************************************
  *              Abstract container for spin color diagonal noise              *
  ******************************************************************************/
@@ -47,35 +116,50 @@ public:
 public:
     // constructor/destructor
     SpinColorDiagonalNoise(GridCartesian *g);
-    SpinColorDiagonalNoise(GridCartesian *g, const int nNoise);
+    SpinColorDiagonalNoise(GridCartesian *g, const int nNoise,
+                           const bool counterBased = false);
     virtual ~SpinColorDiagonalNoise(void) = default;
     // access
     std::vector<LatticeComplex> &       getNoise(void);
     const std::vector<LatticeComplex> & getNoise(void) const;
     FermionField &                      getFerm(const int i);
+    void                                getFerm(std::vector<FermionField> &ferm,
+                                                const int i, const unsigned int n,
+                                                const unsigned int offset = 0);
     PropagatorField &                   getProp(const int i);
     void                                resize(const int nNoise);
     int                                 size(void) const;
     int                                 fermSize(void) const;
     virtual int                         dilutionSize(void) const = 0;
     GridCartesian                       *getGrid(void) const;
+    bool                                isCounterBased(void) const;
     // generate noise
     void generateNoise(GridParallelRNG &rng);
+    void generateNoise(const uint64_t seed);
 private:
-    void         setFerm(const int i);
-    virtual void setProp(const int i) = 0;
+    void                           setProp(const int i);
+    const LatticeComplex &         getDilutedEta(const int i);
+    virtual const LatticeComplex & dilutedEta(const int i) = 0;
+    void                           fillFerm(std::vector<FermionField *> &ferm,
+                                            const std::vector<int> &sc,
+                                            const LatticeComplex &eta);
     LatticeComplex                 eta_;
     FermionField                   ferm_;
     GridCartesian                  *grid_;
     std::vector<LatticeComplex>    noise_;
-    PropagatorField                prop_;
+    std::unique_ptr<PropagatorField> prop_;
+    bool                           counterBased_{false};
+    uint64_t                       seed_{0};
+    int                            nNoise_{0}, hitIndex_{-1}, etaIndex_{-1};
+    const LatticeComplex           *dilEta_{nullptr};
 protected:
+    const LatticeComplex & getHit(const int n);
     LatticeComplex &  getEta(void);
     FermionField &    getFerm(void);
     int               getNd(void) const;
     int               getNsc(void) const;
     PropagatorField & getProp(void);
-    void              setPropagator(LatticeComplex & eta);
+    void              setPropagator(const LatticeComplex & eta);
 };
 
 
@@ -91,35 +175,50 @@ public:
 public:
     // constructor/destructor
     ColorDiagonalNoise(GridCartesian *g);
-    ColorDiagonalNoise(GridCartesian *g, const int nNoise);
+    ColorDiagonalNoise(GridCartesian *g, const int nNoise,
+                       const bool counterBased = false);
     virtual ~ColorDiagonalNoise(void) = default;
     // access
     std::vector<LatticeComplex> &       getNoise(void);
     const std::vector<LatticeComplex> & getNoise(void) const;
     FermionField &                      getFerm(const int i);
+    void                                getFerm(std::vector<FermionField> &ferm,
+                                                const int i, const unsigned int n,
+                                                const unsigned int offset = 0);
     PropagatorField &                   getProp(const int i);
     void                                resize(const int nNoise);
     int                                 size(void) const;
     int                                 fermSize(void) const;
     virtual int                         dilutionSize(void) const = 0;
     GridCartesian                       *getGrid(void) const;
+    bool                                isCounterBased(void) const;
     // generate noise
     void generateNoise(GridParallelRNG &rng);
+    void generateNoise(const uint64_t seed);
 private:
-    void         setFerm(const int i);
-    virtual void setProp(const int i) = 0;
+    void                           setProp(const int i);
+    const LatticeComplex &         getDilutedEta(const int i);
+    virtual const LatticeComplex & dilutedEta(const int i) = 0;
+    void                           fillFerm(std::vector<FermionField *> &ferm,
+                                            const std::vector<int> &sc,
+                                            const LatticeComplex &eta);
     LatticeComplex                 eta_;
     FermionField                   ferm_;
     GridCartesian                  *grid_;
     std::vector<LatticeComplex>    noise_;
-    PropagatorField                prop_;
+    std::unique_ptr<PropagatorField> prop_;
+    bool                           counterBased_{false};
+    uint64_t                       seed_{0};
+    int                            nNoise_{0}, hitIndex_{-1}, etaIndex_{-1};
+    const LatticeComplex           *dilEta_{nullptr};
 protected:
+    const LatticeComplex & getHit(const int n);
     LatticeComplex &  getEta(void);
     FermionField &    getFerm(void);
     int               getNd(void) const;
     int               getNsc(void) const;
     PropagatorField & getProp(void);
-    void              setPropagator(LatticeComplex & eta);
+    void              setPropagator(const LatticeComplex & eta);
 };
 
 
@@ -133,11 +232,12 @@ public:
 public:
     // constructor/destructor
     TimeDilutedNoise(GridCartesian *g);
-    TimeDilutedNoise(GridCartesian *g, const int nNoise);
+    TimeDilutedNoise(GridCartesian *g, const int nNoise,
+                     const bool counterBased = false);
     virtual ~TimeDilutedNoise(void) = default;
     int dilutionSize(void) const;
 private:
-    void setProp(const int i);
+    const LatticeComplex & dilutedEta(const int i);
     Lattice<iScalar<vInteger>> tLat_;
 };
 
@@ -150,11 +250,12 @@ public:
 public:
     // constructor/destructor
     StagTimeDilutedNoise(GridCartesian *g);
-    StagTimeDilutedNoise(GridCartesian *g, const int nNoise);
+    StagTimeDilutedNoise(GridCartesian *g, const int nNoise,
+                         const bool counterBased = false);
     virtual ~StagTimeDilutedNoise(void) = default;
     int dilutionSize(void) const;
 private:
-    void setProp(const int i);
+    const LatticeComplex & dilutedEta(const int i);
     Lattice<iScalar<vInteger>> tLat_;
 };
 
@@ -166,11 +267,12 @@ public:
     typedef typename FImpl::PropagatorField PropagatorField;
 public:
     // constructor/destructor
-    FullVolumeNoise(GridCartesian *g, const int nNoise);
+    FullVolumeNoise(GridCartesian *g, const int nNoise,
+                    const bool counterBased = false);
     virtual ~FullVolumeNoise(void) = default;
     int dilutionSize(void) const;
 private:
-    void setProp(const int i);
+    const LatticeComplex & dilutedEta(const int i);
 };
 
 template <typename FImpl>
@@ -181,11 +283,12 @@ public:
     typedef typename FImpl::PropagatorField PropagatorField;
 public:
     // constructor/destructor
-    StagFullVolumeNoise(GridCartesian *g, const int nNoise);
+    StagFullVolumeNoise(GridCartesian *g, const int nNoise,
+                        const bool counterBased = false);
     virtual ~StagFullVolumeNoise(void) = default;
     int dilutionSize(void) const;
 private:
-    void setProp(const int i);
+    const LatticeComplex & dilutedEta(const int i);
 };
 
 template <typename FImpl>
@@ -196,11 +299,12 @@ public:
     typedef typename FImpl::PropagatorField PropagatorField;
 public:
     // constructor/destructor
-    CheckerboardNoise(GridCartesian *g, const int nNoise, const int nSparse);
+    CheckerboardNoise(GridCartesian *g, const int nNoise, const int nSparse,
+                      const bool counterBased = false);
     virtual ~CheckerboardNoise(void) = default;
     int dilutionSize(void) const;
 private:
-    void setProp(const int i);
+    const LatticeComplex & dilutedEta(const int i);
     int nSparse_, nSrc_ec_;
     LatticeInteger coor_, coorTot_;
 };
@@ -213,11 +317,12 @@ public:
     typedef typename FImpl::PropagatorField PropagatorField;
 public:
     // constructor/destructor
-    SparseNoise(GridCartesian *g, const int nNoise, const int nSparse);
+    SparseNoise(GridCartesian *g, const int nNoise, const int nSparse,
+                const bool counterBased = false);
     virtual ~SparseNoise(void) = default;
     int dilutionSize(void) const;
 private:
-    void setProp(const int i);
+    const LatticeComplex & dilutedEta(const int i);
     int nSparse_;
     LatticeInteger coor_;
 };
@@ -227,14 +332,16 @@ private:
  ******************************************************************************/
 template <typename FImpl>
 SpinColorDiagonalNoise<FImpl>::SpinColorDiagonalNoise(GridCartesian *g)
-: grid_(g), ferm_(g), prop_(g), eta_(g)
+: grid_(g), ferm_(g), eta_(g)
 {}
 
 template <typename FImpl>
 SpinColorDiagonalNoise<FImpl>::SpinColorDiagonalNoise(GridCartesian *g,
-                                                      const int nNoise)
+                                                      const int nNoise,
+                                                      const bool counterBased)
 : SpinColorDiagonalNoise(g)
 {
+    counterBased_ = counterBased;
     resize(nNoise);
 }
 
@@ -252,16 +359,6 @@ getNoise(void) const
     return noise_;
 }
 
-template <typename FImpl>
-void SpinColorDiagonalNoise<FImpl>::setFerm(const int i)
-{
-    int nc  = FImpl::Dimension;
-    std::div_t divs;
-    divs = std::div(i, nc);
-
-    PropToFerm<FImpl>(ferm_, prop_, divs.quot, divs.rem);
-}
-
 template <typename FImpl>
 typename SpinColorDiagonalNoise<FImpl>::FermionField & 
 SpinColorDiagonalNoise<FImpl>::getFerm(void)
@@ -273,26 +370,117 @@ template <typename FImpl>
 typename SpinColorDiagonalNoise<FImpl>::FermionField & 
 SpinColorDiagonalNoise<FImpl>::getFerm(const int i)
 {
-    auto nsc   = this->getNsc();
-    std::div_t divs;
-    divs = std::div(i, nsc);
-    setProp(divs.quot);
-    setFerm(divs.rem);
+    auto                        nsc = this->getNsc();
+    std::vector<FermionField *> f   = {&ferm_};
+    std::vector<int>            sc  = {i%nsc};
+
+    fillFerm(f, sc, getDilutedEta(i/nsc));
+
     return getFerm();
 }
 
 template <typename FImpl>
-void SpinColorDiagonalNoise<FImpl>::setPropagator(LatticeComplex & eta)
+void SpinColorDiagonalNoise<FImpl>::getFerm(std::vector<FermionField> &ferm,
+                                            const int i, const unsigned int n,
+                                            const unsigned int offset)
 {
-    prop_ = 1.;
-    prop_ = prop_*eta;
+    auto         nsc = this->getNsc();
+    unsigned int k   = 0;
+
+    if (offset + n > ferm.size())
+    {
+        HADRONS_ERROR(Size, "fermion buffer too small for "
+                      + std::to_string(n) + " diluted sources");
+    }
+    while (k < n)
+    {
+        const int                   d = (i + k)/nsc;
+        std::vector<FermionField *> f;
+        std::vector<int>            sc;
+
+        // all components of the same dilution index are filled in one sweep
+        while ((k < n) and ((i + k)/nsc == d))
+        {
+            f.push_back(&ferm[offset + k]);
+            sc.push_back((i + k)%nsc);
+            k++;
+        }
+        fillFerm(f, sc, getDilutedEta(d));
+    }
+}
+
+template <typename FImpl>
+void SpinColorDiagonalNoise<FImpl>::fillFerm(std::vector<FermionField *> &ferm,
+                                             const std::vector<int> &sc,
+                                             const LatticeComplex &eta)
+{
+    typedef typename FermionField::vector_object vobj;
+    typedef decltype(ferm[0]->View(CpuWrite))    FermionView;
+
+    const int                nc = FImpl::Dimension;
+    std::vector<FermionView> f_v;
+
+    for (auto f: ferm)
+    {
+        f_v.push_back(f->View(CpuWrite));
+    }
+    {
+        autoView(eta_v, eta, CpuRead);
+        thread_for(ss, grid_->oSites(),
+        {
+            for (unsigned int k = 0; k < f_v.size(); ++k)
+            {
+                vobj v = Zero();
+
+                v()(sc[k]/nc)(sc[k]%nc) = eta_v[ss]()()();
+                f_v[k][ss] = v;
+            }
+        });
+    }
+    for (auto &v: f_v)
+    {
+        v.ViewClose();
+    }
+}
+
+template <typename FImpl>
+const LatticeComplex & SpinColorDiagonalNoise<FImpl>::getDilutedEta(const int i)
+{
+    if ((dilEta_ == nullptr) or (i != etaIndex_))
+    {
+        dilEta_   = &dilutedEta(i);
+        etaIndex_ = i;
+    }
+
+    return *dilEta_;
+}
+
+template <typename FImpl>
+void SpinColorDiagonalNoise<FImpl>::setProp(const int i)
+{
+    setPropagator(getDilutedEta(i));
+}
+
+template <typename FImpl>
+void SpinColorDiagonalNoise<FImpl>::setPropagator(const LatticeComplex & eta)
+{
+    auto &prop = getProp();
+
+    prop = 1.;
+    prop = prop*eta;
 }
 
 template <typename FImpl>
 typename SpinColorDiagonalNoise<FImpl>::PropagatorField & 
 SpinColorDiagonalNoise<FImpl>::getProp(void)
 {
-    return prop_;
+    // only allocated if a full propagator source is actually requested
+    if (!prop_)
+    {
+        prop_.reset(new PropagatorField(grid_));
+    }
+
+    return *prop_;
 }
 
 template <typename FImpl>
@@ -306,7 +494,7 @@ SpinColorDiagonalNoise<FImpl>::getProp(const int i)
 template <typename FImpl>
 int SpinColorDiagonalNoise<FImpl>::size(void) const
 {
-    return noise_.size();
+    return nNoise_;
 }
 
 template <typename FImpl>
@@ -336,7 +524,35 @@ int SpinColorDiagonalNoise<FImpl>::getNsc(void) const
 template <typename FImpl>
 void SpinColorDiagonalNoise<FImpl>::resize(const int nNoise)
 {
-    noise_.resize(nNoise, grid_);
+    // in counter-based mode a single field holds the last regenerated hit
+    nNoise_   = nNoise;
+    hitIndex_ = -1;
+    etaIndex_ = -1;
+    noise_.resize(counterBased_ ? std::min(nNoise, 1) : nNoise, grid_);
+}
+
+template <typename FImpl>
+bool SpinColorDiagonalNoise<FImpl>::isCounterBased(void) const
+{
+    return counterBased_;
+}
+
+template <typename FImpl>
+const LatticeComplex & SpinColorDiagonalNoise<FImpl>::getHit(const int n)
+{
+    if (counterBased_)
+    {
+        if (n != hitIndex_)
+        {
+            counterNoise(noise_[0], seed_, n);
+            hitIndex_ = n;
+        }
+        return noise_[0];
+    }
+    else
+    {
+        return noise_[n];
+    }
 }
 
 template <typename FImpl>
@@ -348,6 +564,11 @@ GridCartesian * SpinColorDiagonalNoise<FImpl>::getGrid(void) const
 template <typename FImpl>
 void SpinColorDiagonalNoise<FImpl>::generateNoise(GridParallelRNG &rng)
 {
+    if (counterBased_)
+    {
+        HADRONS_ERROR(Definition, "counter-based noise must be generated from a seed");
+    }
+    etaIndex_ = -1;
     Complex        shift(1., 1.);
     for (int n = 0; n < noise_.size(); ++n)
     {
@@ -357,6 +578,18 @@ void SpinColorDiagonalNoise<FImpl>::generateNoise(GridParallelRNG &rng)
     }
 }
 
+template <typename FImpl>
+void SpinColorDiagonalNoise<FImpl>::generateNoise(const uint64_t seed)
+{
+    if (!counterBased_)
+    {
+        HADRONS_ERROR(Definition, "stored noise must be generated from a RNG");
+    }
+    seed_     = seed;
+    hitIndex_ = -1;
+    etaIndex_ = -1;
+}
+
 
 
 /******************************************************************************
@@ -364,14 +597,16 @@ void SpinColorDiagonalNoise<FImpl>::generateNoise(GridParallelRNG &rng)
  ******************************************************************************/
 template <typename FImpl>
 ColorDiagonalNoise<FImpl>::ColorDiagonalNoise(GridCartesian *g)
-: grid_(g), ferm_(g), prop_(g), eta_(g)
+: grid_(g), ferm_(g), eta_(g)
 {}
 
 template <typename FImpl>
 ColorDiagonalNoise<FImpl>::ColorDiagonalNoise(GridCartesian *g,
-                                              const int nNoise)
+                                              const int nNoise,
+                                              const bool counterBased)
 : ColorDiagonalNoise(g)
 {
+    counterBased_ = counterBased;
     resize(nNoise);
 }
 
@@ -389,16 +624,6 @@ getNoise(void) const
     return noise_;
 }
 
-template <typename FImpl>
-void ColorDiagonalNoise<FImpl>::setFerm(const int i)
-{
-    //int nc  = FImpl::Dimension;
-    //std::div_t divs;
-    //divs = std::div(i, nc);
-
-    PropToFerm<FImpl>(ferm_, prop_, i);
-}
-
 template <typename FImpl>
 typename ColorDiagonalNoise<FImpl>::FermionField &
 ColorDiagonalNoise<FImpl>::getFerm(void)
@@ -410,28 +635,116 @@ template <typename FImpl>
 typename ColorDiagonalNoise<FImpl>::FermionField &
 ColorDiagonalNoise<FImpl>::getFerm(const int i)
 {
-    auto nsc   = this->getNsc();
-    std::div_t divs;
-    divs = std::div(i, nsc);
-    // both should be remainder?
-    //LOG(Message) << "setProp i= " << divs.rem << std::endl;
-    setProp(divs.quot);
-    setFerm(divs.rem);
+    auto                        nsc = this->getNsc();
+    std::vector<FermionField *> f   = {&ferm_};
+    std::vector<int>            sc  = {i%nsc};
+
+    fillFerm(f, sc, getDilutedEta(i/nsc));
+
     return getFerm();
 }
 
 template <typename FImpl>
-void ColorDiagonalNoise<FImpl>::setPropagator(LatticeComplex & eta)
+void ColorDiagonalNoise<FImpl>::getFerm(std::vector<FermionField> &ferm,
+                                        const int i, const unsigned int n,
+                                        const unsigned int offset)
 {
-    prop_ = 1.;
-    prop_ = prop_*eta;
+    auto         nsc = this->getNsc();
+    unsigned int k   = 0;
+
+    if (offset + n > ferm.size())
+    {
+        HADRONS_ERROR(Size, "fermion buffer too small for "
+                      + std::to_string(n) + " diluted sources");
+    }
+    while (k < n)
+    {
+        const int                   d = (i + k)/nsc;
+        std::vector<FermionField *> f;
+        std::vector<int>            sc;
+
+        // all components of the same dilution index are filled in one sweep
+        while ((k < n) and ((i + k)/nsc == d))
+        {
+            f.push_back(&ferm[offset + k]);
+            sc.push_back((i + k)%nsc);
+            k++;
+        }
+        fillFerm(f, sc, getDilutedEta(d));
+    }
+}
+
+template <typename FImpl>
+void ColorDiagonalNoise<FImpl>::fillFerm(std::vector<FermionField *> &ferm,
+                                         const std::vector<int> &sc,
+                                         const LatticeComplex &eta)
+{
+    typedef typename FermionField::vector_object vobj;
+    typedef decltype(ferm[0]->View(CpuWrite))    FermionView;
+
+    std::vector<FermionView> f_v;
+
+    for (auto f: ferm)
+    {
+        f_v.push_back(f->View(CpuWrite));
+    }
+    {
+        autoView(eta_v, eta, CpuRead);
+        thread_for(ss, grid_->oSites(),
+        {
+            for (unsigned int k = 0; k < f_v.size(); ++k)
+            {
+                vobj v = Zero();
+
+                v()()(sc[k]) = eta_v[ss]()()();
+                f_v[k][ss] = v;
+            }
+        });
+    }
+    for (auto &v: f_v)
+    {
+        v.ViewClose();
+    }
+}
+
+template <typename FImpl>
+const LatticeComplex & ColorDiagonalNoise<FImpl>::getDilutedEta(const int i)
+{
+    if ((dilEta_ == nullptr) or (i != etaIndex_))
+    {
+        dilEta_   = &dilutedEta(i);
+        etaIndex_ = i;
+    }
+
+    return *dilEta_;
+}
+
+template <typename FImpl>
+void ColorDiagonalNoise<FImpl>::setProp(const int i)
+{
+    setPropagator(getDilutedEta(i));
+}
+
+template <typename FImpl>
+void ColorDiagonalNoise<FImpl>::setPropagator(const LatticeComplex & eta)
+{
+    auto &prop = getProp();
+
+    prop = 1.;
+    prop = prop*eta;
 }
 
 template <typename FImpl>
 typename ColorDiagonalNoise<FImpl>::PropagatorField &
 ColorDiagonalNoise<FImpl>::getProp(void)
 {
-    return prop_;
+    // only allocated if a full propagator source is actually requested
+    if (!prop_)
+    {
+        prop_.reset(new PropagatorField(grid_));
+    }
+
+    return *prop_;
 }
 
 template <typename FImpl>
@@ -445,7 +758,7 @@ ColorDiagonalNoise<FImpl>::getProp(const int i)
 template <typename FImpl>
 int ColorDiagonalNoise<FImpl>::size(void) const
 {
-    return noise_.size();
+    return nNoise_;
 }
 
 template <typename FImpl>
@@ -475,7 +788,35 @@ int ColorDiagonalNoise<FImpl>::getNsc(void) const
 template <typename FImpl>
 void ColorDiagonalNoise<FImpl>::resize(const int nNoise)
 {
-    noise_.resize(nNoise, grid_);
+    // in counter-based mode a single field holds the last regenerated hit
+    nNoise_   = nNoise;
+    hitIndex_ = -1;
+    etaIndex_ = -1;
+    noise_.resize(counterBased_ ? std::min(nNoise, 1) : nNoise, grid_);
+}
+
+template <typename FImpl>
+bool ColorDiagonalNoise<FImpl>::isCounterBased(void) const
+{
+    return counterBased_;
+}
+
+template <typename FImpl>
+const LatticeComplex & ColorDiagonalNoise<FImpl>::getHit(const int n)
+{
+    if (counterBased_)
+    {
+        if (n != hitIndex_)
+        {
+            counterNoise(noise_[0], seed_, n);
+            hitIndex_ = n;
+        }
+        return noise_[0];
+    }
+    else
+    {
+        return noise_[n];
+    }
 }
 
 template <typename FImpl>
@@ -487,6 +828,11 @@ GridCartesian * ColorDiagonalNoise<FImpl>::getGrid(void) const
 template <typename FImpl>
 void ColorDiagonalNoise<FImpl>::generateNoise(GridParallelRNG &rng)
 {
+    if (counterBased_)
+    {
+        HADRONS_ERROR(Definition, "counter-based noise must be generated from a seed");
+    }
+    etaIndex_ = -1;
     Complex        shift(1., 1.);
     for (int n = 0; n < noise_.size(); ++n)
     {
@@ -497,6 +843,18 @@ void ColorDiagonalNoise<FImpl>::generateNoise(GridParallelRNG &rng)
     }
 }
 
+template <typename FImpl>
+void ColorDiagonalNoise<FImpl>::generateNoise(const uint64_t seed)
+{
+    if (!counterBased_)
+    {
+        HADRONS_ERROR(Definition, "stored noise must be generated from a RNG");
+    }
+    seed_     = seed;
+    hitIndex_ = -1;
+    etaIndex_ = -1;
+}
+
 
 
 
@@ -505,8 +863,9 @@ void ColorDiagonalNoise<FImpl>::generateNoise(GridParallelRNG &rng)
  ******************************************************************************/
 template <typename FImpl>
 TimeDilutedNoise<FImpl>::
-TimeDilutedNoise(GridCartesian *g, int nNoise)
-: SpinColorDiagonalNoise<FImpl>(g, nNoise), tLat_(g)
+TimeDilutedNoise(GridCartesian *g, int nNoise,
+                 const bool counterBased)
+: SpinColorDiagonalNoise<FImpl>(g, nNoise, counterBased), tLat_(g)
 {}
 
 template <typename FImpl>
@@ -517,10 +876,9 @@ int TimeDilutedNoise<FImpl>::dilutionSize() const
 }
 
 template <typename FImpl>
-void TimeDilutedNoise<FImpl>::setProp(const int i)
+const LatticeComplex & TimeDilutedNoise<FImpl>::dilutedEta(const int i)
 {
-    auto eta   = this->getEta();
-    auto noise = this->getNoise();
+    auto &eta  = this->getEta();
     auto nd    = this->getNd();
     auto nt    = this->getGrid()->GlobalDimensions()[Tp];
 
@@ -528,9 +886,11 @@ void TimeDilutedNoise<FImpl>::setProp(const int i)
 
     std::div_t divs = std::div(i, nt);
     int t = divs.rem;
+    auto &noise = this->getHit(divs.quot);
 
-    eta = where((tLat_ == t), noise[divs.quot], 0.*noise[divs.quot]);
-    this->setPropagator(eta);
+    eta = where((tLat_ == t), noise, 0.*noise);
+
+    return eta;
 }
 
 /******************************************************************************
@@ -538,8 +898,9 @@ void TimeDilutedNoise<FImpl>::setProp(const int i)
  ******************************************************************************/
 template <typename FImpl>
 StagTimeDilutedNoise<FImpl>::
-StagTimeDilutedNoise(GridCartesian *g, int nNoise)
-: ColorDiagonalNoise<FImpl>(g, nNoise), tLat_(g)
+StagTimeDilutedNoise(GridCartesian *g, int nNoise,
+                     const bool counterBased)
+: ColorDiagonalNoise<FImpl>(g, nNoise, counterBased), tLat_(g)
 {}
 
 template <typename FImpl>
@@ -550,10 +911,9 @@ int StagTimeDilutedNoise<FImpl>::dilutionSize() const
 }
 
 template <typename FImpl>
-void StagTimeDilutedNoise<FImpl>::setProp(const int i)
+const LatticeComplex & StagTimeDilutedNoise<FImpl>::dilutedEta(const int i)
 {
-    auto eta   = this->getEta();
-    auto noise = this->getNoise();
+    auto &eta  = this->getEta();
     auto nd    = this->getNd();
     auto nt    = this->getGrid()->GlobalDimensions()[Tp];
 
@@ -561,9 +921,11 @@ void StagTimeDilutedNoise<FImpl>::setProp(const int i)
 
     std::div_t divs = std::div(i, nt);
     int t = divs.rem;
+    auto &noise = this->getHit(divs.quot);
+
+    eta = where((tLat_ == t), noise, 0.*noise);
 
-    eta = where((tLat_ == t), noise[divs.quot], 0.*noise[divs.quot]);
-    this->setPropagator(eta);
+    return eta;
 }
 
 /******************************************************************************
@@ -571,8 +933,9 @@ void StagTimeDilutedNoise<FImpl>::setProp(const int i)
  ******************************************************************************/
 template <typename FImpl>
 StagFullVolumeNoise<FImpl>::
-StagFullVolumeNoise(GridCartesian *g, int nNoise)
-: ColorDiagonalNoise<FImpl>(g, nNoise)
+StagFullVolumeNoise(GridCartesian *g, int nNoise,
+                    const bool counterBased)
+: ColorDiagonalNoise<FImpl>(g, nNoise, counterBased)
 {}
 
 template <typename FImpl>
@@ -582,10 +945,9 @@ int StagFullVolumeNoise<FImpl>::dilutionSize() const
 }
 
 template <typename FImpl>
-void StagFullVolumeNoise<FImpl>::setProp(const int i)
+const LatticeComplex & StagFullVolumeNoise<FImpl>::dilutedEta(const int i)
 {
-    auto noise = this->getNoise();
-    this->setPropagator(noise[i]);
+    return this->getHit(i);
 }
 
 /******************************************************************************
@@ -593,8 +955,9 @@ void StagFullVolumeNoise<FImpl>::setProp(const int i)
  ******************************************************************************/
 template <typename FImpl>
 FullVolumeNoise<FImpl>::
-FullVolumeNoise(GridCartesian *g, int nNoise)
-: SpinColorDiagonalNoise<FImpl>(g, nNoise)
+FullVolumeNoise(GridCartesian *g, int nNoise,
+                const bool counterBased)
+: SpinColorDiagonalNoise<FImpl>(g, nNoise, counterBased)
 {}
 
 template <typename FImpl>
@@ -604,10 +967,9 @@ int FullVolumeNoise<FImpl>::dilutionSize() const
 }
 
 template <typename FImpl>
-void FullVolumeNoise<FImpl>::setProp(const int i)
+const LatticeComplex & FullVolumeNoise<FImpl>::dilutedEta(const int i)
 {
-    auto noise = this->getNoise();
-    this->setPropagator(noise[i]);
+    return this->getHit(i);
 }
 
 /******************************************************************************
@@ -615,8 +977,9 @@ void FullVolumeNoise<FImpl>::setProp(const int i)
  ******************************************************************************/
 template <typename FImpl>
 CheckerboardNoise<FImpl>::
-CheckerboardNoise(GridCartesian *g, int nNoise, int nSparse)
-: SpinColorDiagonalNoise<FImpl>(g, nNoise), nSparse_(nSparse),
+CheckerboardNoise(GridCartesian *g, int nNoise, int nSparse,
+                  const bool counterBased)
+: SpinColorDiagonalNoise<FImpl>(g, nNoise, counterBased), nSparse_(nSparse),
   coor_(g), coorTot_(g)
 {
     if(nNoise%nSparse_==0)
@@ -636,14 +999,12 @@ int CheckerboardNoise<FImpl>::dilutionSize() const
 }
 
 template <typename FImpl>
-void CheckerboardNoise<FImpl>::setProp(const int i)
+const LatticeComplex & CheckerboardNoise<FImpl>::dilutedEta(const int i)
 {
-    auto eta   = this->getEta();
+    auto &eta  = this->getEta();
     auto nd    = this->getNd();
-    auto noise = this->getNoise();
-    auto nsc   = this->getNsc();
     unsigned int j;
-    eta = noise[i];
+    eta = this->getHit(i);
     j   = i/nSrc_ec_;
 
     coorTot_ = 0.;
@@ -656,7 +1017,8 @@ void CheckerboardNoise<FImpl>::setProp(const int i)
     coorTot_ = coorTot_ + coor_;
     eta = where(mod(coorTot_,nSparse_), 0.*eta, eta);
     eta *= sqrt(1./nSrc_ec_);
-    this->setPropagator(eta);
+
+    return eta;
 }
 
 /******************************************************************************
@@ -664,8 +1026,9 @@ void CheckerboardNoise<FImpl>::setProp(const int i)
  ******************************************************************************/
 template <typename FImpl>
 SparseNoise<FImpl>::
-SparseNoise(GridCartesian *g, int nNoise, int nSparse)
-: SpinColorDiagonalNoise<FImpl>(g, nNoise), nSparse_(nSparse), coor_(g)
+SparseNoise(GridCartesian *g, int nNoise, int nSparse,
+            const bool counterBased)
+: SpinColorDiagonalNoise<FImpl>(g, nNoise, counterBased), nSparse_(nSparse), coor_(g)
 {}
 
 template <typename FImpl>
@@ -676,14 +1039,13 @@ int SparseNoise<FImpl>::dilutionSize() const
 }
 
 template <typename FImpl>
-void SparseNoise<FImpl>::setProp(const int i)
+const LatticeComplex & SparseNoise<FImpl>::dilutedEta(const int i)
 {
-    auto eta   = this->getEta();
+    auto &eta  = this->getEta();
     auto nd    = this->getNd();
-    auto noise = this->getNoise();
 
     std::div_t divs = std::div(i, pow(nSparse_, nd));
-    eta = noise[divs.quot];
+    eta = this->getHit(divs.quot);
     for(int d = 0; d < nd; ++d) 
     {
         LatticeCoordinate(coor_, d);
@@ -695,7 +1057,8 @@ void SparseNoise<FImpl>::setProp(const int i)
         divs = std::div(divs.rem, pow(nSparse_, nd-(d+1)));
         eta = Cshift(eta, d, divs.quot);
     }
-    this->setPropagator(eta);
+
+    return eta;
 }
 
 END_HADRONS_NAMESPACE
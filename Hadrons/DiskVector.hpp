@@ -101,10 +101,14 @@ public:
     void setGrid(GridBase *grid_);
     GridBase *getGrid() const;
     GridBase *dvGrid;
+protected:
+    virtual std::string filename(const unsigned int i) const;
+    // pointer to element i if it is in the cache, nullptr otherwise
+    // (no access statistics or cache reordering)
+    const T * cachedElement(const unsigned int i) const;
 private:
     virtual void load(T &obj, const std::string filename) const = 0;
     virtual void save(const std::string filename, const T &obj) const = 0;
-    virtual std::string filename(const unsigned int i) const;
     void evict(void) const;
     void fetch(const unsigned int i) const;
     void cacheInsert(const unsigned int i, const T &obj) const;
@@ -275,72 +279,171 @@ public:
     {
         return (*this)[i](mu, j, k, m);
     }
+
+    // partial load of element t: spin components [muBegin, muBegin + nMu)
+    // and first A2A index range [iBegin, iBegin + nI), all j and k
+    // (nMu = 0 or nI = 0 mean up to the end of the dimension).
+    // The file layout is (mu, i, j, k) row-major, so each spin component of
+    // the slab is one contiguous read. The slab is served from the cache if
+    // the element is already there, and does not enter the cache otherwise.
+    // The element checksum covers the full tensor and is not verified here.
+    void loadSlab(Tensor &obj, const unsigned int t,
+                  const Eigen::Index muBegin, Eigen::Index nMu,
+                  const Eigen::Index iBegin = 0, Eigen::Index nI = 0) const
+    {
+        GridBase     *loadGrid = (*this).getGrid();
+        const Tensor *cached   = this->cachedElement(t);
+        Eigen::Index dim[4];
+
+        if (cached)
+        {
+            for (unsigned int d = 0; d < 4; ++d)
+            {
+                dim[d] = cached->dimension(d);
+            }
+        }
+        else if (!(loadGrid) || loadGrid->IsBoss())
+        {
+            std::ifstream f(this->filename(t), std::ios::binary);
+            uint32_t      crc;
+
+            if (!f.good())
+            {
+                HADRONS_ERROR(Io, "disk vector element " + std::to_string(t) + " uninitialised");
+            }
+            readHeader(f, crc, dim);
+        }
+        if (loadGrid and !cached)
+        {
+            loadGrid->Broadcast(loadGrid->BossRank(), dim, sizeof(dim));
+        }
+        nMu = (nMu == 0) ? dim[0] - muBegin : nMu;
+        nI  = (nI == 0) ? dim[1] - iBegin : nI;
+        if ((muBegin + nMu > dim[0]) or (iBegin + nI > dim[1]))
+        {
+            HADRONS_ERROR(Size, "nucleon tensor slab out of range");
+        }
+        obj.resize(nMu, nI, dim[2], dim[3]);
+        if (cached)
+        {
+            Eigen::array<Eigen::Index, 4> offsets = {muBegin, iBegin, 0, 0};
+            Eigen::array<Eigen::Index, 4> extents = {nMu, nI, dim[2], dim[3]};
+
+            obj = cached->slice(offsets, extents);
+
+            return;
+        }
+        if (!(loadGrid) || loadGrid->IsBoss())
+        {
+            std::ifstream f(this->filename(t), std::ios::binary);
+            const size_t  rowSize = dim[2]*dim[3]*sizeof(T);
+            const size_t  header  = sizeof(uint32_t) + 4*sizeof(Eigen::Index);
+            double        tRead;
+
+            tRead = -usecond();
+            for (Eigen::Index mu = 0; mu < nMu; ++mu)
+            {
+                f.seekg(header + ((muBegin + mu)*dim[1] + iBegin)*rowSize);
+                f.read(reinterpret_cast<char *>(obj.data() + mu*nI*dim[2]*dim[3]), nI*rowSize);
+            }
+            tRead += usecond();
+            DV_DEBUG_MSG(this, "Eigen slab read " << tRead/1.0e6 << " sec " << nMu*nI*rowSize/tRead*1.0e6/1024/1024 << " MB/s");
+        }
+        if (loadGrid)
+        {
+            loadGrid->Broadcast(loadGrid->BossRank(), obj.data(), sizeof(T)*obj.size());
+            loadGrid->Barrier();
+        }
+    }
 private:
+    static void readHeader(std::ifstream &f, uint32_t &crc, Eigen::Index dim[4])
+    {
+        f.read(reinterpret_cast<char *>(&crc), sizeof(crc));
+        for (unsigned int d = 0; d < 4; ++d)
+        {
+            f.read(reinterpret_cast<char *>(&dim[d]), sizeof(dim[d]));
+        }
+    }
+
     virtual void load(EigenDiskVectorTen<T> &obj, const std::string filename) const
     {
-        std::ifstream f(filename, std::ios::binary);
-        uint32_t      crc, check;
-        Eigen::Index  nRow_mu, nRow_j, nRow_k, nRow_m;
-        size_t        tenSize;
-        double        tRead, tHash;
+        GridBase     *loadGrid = (*this).getGrid();
+        Eigen::Index dim[4];
 
-        f.read(reinterpret_cast<char *>(&crc), sizeof(crc));
-        f.read(reinterpret_cast<char *>(&nRow_mu), sizeof(nRow_mu));
-        f.read(reinterpret_cast<char *>(&nRow_j), sizeof(nRow_j));
-        f.read(reinterpret_cast<char *>(&nRow_k), sizeof(nRow_k));
-        f.read(reinterpret_cast<char *>(&nRow_m), sizeof(nRow_m));
-        obj.resize(nRow_mu, nRow_j, nRow_k, nRow_m); // MCA - need to make sure this can be done with tensors
-        tenSize = nRow_mu*nRow_j*nRow_k*nRow_m*sizeof(T);
-        tRead  = -usecond();
-        f.read(reinterpret_cast<char *>(obj.data()), tenSize);
-        tRead += usecond();
-        tHash  = -usecond();
+        if (!(loadGrid) || loadGrid->IsBoss())
+        {
+            std::ifstream f(filename, std::ios::binary);
+            uint32_t      crc, check;
+            size_t        tenSize;
+            double        tRead, tHash;
+
+            readHeader(f, crc, dim);
+            obj.resize(dim[0], dim[1], dim[2], dim[3]);
+            tenSize = obj.size()*sizeof(T);
+            tRead  = -usecond();
+            f.read(reinterpret_cast<char *>(obj.data()), tenSize);
+            tRead += usecond();
+            tHash  = -usecond();
 #ifdef USE_IPP
-        check  = GridChecksum::crc32c(obj.data(), tenSize);
+            check  = GridChecksum::crc32c(obj.data(), tenSize);
 #else
-        check  = GridChecksum::crc32(obj.data(), tenSize);
+            check  = GridChecksum::crc32(obj.data(), tenSize);
 #endif
-        tHash += usecond();
-        DV_DEBUG_MSG(this, "Eigen read " << tRead/1.0e6 << " sec " << tenSize/tRead*1.0e6/1024/1024 << " MB/s");
-        DV_DEBUG_MSG(this, "Eigen crc32 " << std::hex << check << std::dec
-                     << " " << tHash/1.0e6 << " sec " << tenSize/tHash*1.0e6/1024/1024 << " MB/s");
-        if (crc != check)
+            tHash += usecond();
+            DV_DEBUG_MSG(this, "Eigen read " << tRead/1.0e6 << " sec " << tenSize/tRead*1.0e6/1024/1024 << " MB/s");
+            DV_DEBUG_MSG(this, "Eigen crc32 " << std::hex << check << std::dec
+                         << " " << tHash/1.0e6 << " sec " << tenSize/tHash*1.0e6/1024/1024 << " MB/s");
+            if (crc != check)
+            {
+                HADRONS_ERROR(Io, "checksum failed")
+            }
+        }
+        if (loadGrid)
         {
-            HADRONS_ERROR(Io, "checksum failed")
+            loadGrid->Broadcast(loadGrid->BossRank(), dim, sizeof(dim));
+            obj.resize(dim[0], dim[1], dim[2], dim[3]);
+            loadGrid->Broadcast(loadGrid->BossRank(), obj.data(), sizeof(T)*obj.size());
+            loadGrid->Barrier();
         }
     }
 
     virtual void save(const std::string filename, const EigenDiskVectorTen<T> &obj) const
     {
-        std::ofstream f(filename, std::ios::binary);
-        uint32_t      crc;
-        Eigen::Index  nRow_mu, nRow_j, nRow_k, nRow_m;
-        size_t        tenSize;
-        double        tWrite, tHash;
-        
-        nRow_mu   = obj.dimension(0); // MCA - testing for rank 4 tensors
-        nRow_j    = obj.dimension(1); // MCA - testing for rank 4 tensors
-        nRow_k    = obj.dimension(2); // MCA - testing for rank 4 tensors
-        nRow_m    = obj.dimension(3); // MCA - testing for rank 4 tensors
-        tenSize = nRow_mu*nRow_j*nRow_k*nRow_m*sizeof(T);
-        tHash   = -usecond();
+        GridBase *saveGrid = (*this).getGrid();
+
+        if (!(saveGrid) || saveGrid->IsBoss())
+        {
+            std::ofstream f(filename, std::ios::binary);
+            uint32_t      crc;
+            Eigen::Index  nRow_mu, nRow_j, nRow_k, nRow_m;
+            size_t        tenSize;
+            double        tWrite, tHash;
+            
+            nRow_mu   = obj.dimension(0); // MCA - testing for rank 4 tensors
+            nRow_j    = obj.dimension(1); // MCA - testing for rank 4 tensors
+            nRow_k    = obj.dimension(2); // MCA - testing for rank 4 tensors
+            nRow_m    = obj.dimension(3); // MCA - testing for rank 4 tensors
+            tenSize = nRow_mu*nRow_j*nRow_k*nRow_m*sizeof(T);
+            tHash   = -usecond();
 #ifdef USE_IPP
-        crc     = GridChecksum::crc32c(obj.data(), tenSize);
+            crc     = GridChecksum::crc32c(obj.data(), tenSize);
 #else
-        crc     = GridChecksum::crc32(obj.data(), tenSize);
+            crc     = GridChecksum::crc32(obj.data(), tenSize);
 #endif
-        tHash  += usecond();
-        f.write(reinterpret_cast<char *>(&crc), sizeof(crc));
-        f.write(reinterpret_cast<char *>(&nRow_mu), sizeof(nRow_mu));
-        f.write(reinterpret_cast<char *>(&nRow_j), sizeof(nRow_j));
-        f.write(reinterpret_cast<char *>(&nRow_k), sizeof(nRow_k));
-        f.write(reinterpret_cast<char *>(&nRow_m), sizeof(nRow_m));
-        tWrite = -usecond();
-        f.write(reinterpret_cast<const char *>(obj.data()), tenSize);
-        tWrite += usecond();
-        DV_DEBUG_MSG(this, "Eigen write " << tWrite/1.0e6 << " sec " << tenSize/tWrite*1.0e6/1024/1024 << " MB/s");
-        DV_DEBUG_MSG(this, "Eigen crc32 " << std::hex << crc << std::dec
-                     << " " << tHash/1.0e6 << " sec " << tenSize/tHash*1.0e6/1024/1024 << " MB/s");
+            tHash  += usecond();
+            f.write(reinterpret_cast<char *>(&crc), sizeof(crc));
+            f.write(reinterpret_cast<char *>(&nRow_mu), sizeof(nRow_mu));
+            f.write(reinterpret_cast<char *>(&nRow_j), sizeof(nRow_j));
+            f.write(reinterpret_cast<char *>(&nRow_k), sizeof(nRow_k));
+            f.write(reinterpret_cast<char *>(&nRow_m), sizeof(nRow_m));
+            tWrite = -usecond();
+            f.write(reinterpret_cast<const char *>(obj.data()), tenSize);
+            tWrite += usecond();
+            DV_DEBUG_MSG(this, "Eigen write " << tWrite/1.0e6 << " sec " << tenSize/tWrite*1.0e6/1024/1024 << " MB/s");
+            DV_DEBUG_MSG(this, "Eigen crc32 " << std::hex << crc << std::dec
+                         << " " << tHash/1.0e6 << " sec " << tenSize/tHash*1.0e6/1024/1024 << " MB/s");
+        }
+        if (saveGrid)   saveGrid->Barrier();
     }
 };
 
@@ -489,6 +592,16 @@ std::string DiskVectorBase<T>::filename(const unsigned int i) const
     return dirname_ + "/elem_" + std::to_string(i);
 }
 
+template <typename T>
+const T * DiskVectorBase<T>::cachedElement(const unsigned int i) const
+{
+    auto &cache = *cachePtr_;
+    auto &index = *indexPtr_;
+    auto it     = index.find(i);
+
+    return (it == index.end()) ? nullptr : &cache[it->second];
+}
+
 template <typename T>
 void DiskVectorBase<T>::evict(void) const
 {
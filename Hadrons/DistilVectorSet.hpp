@@ -0,0 +1,341 @@
+/*
+ * DistilVectorSet.hpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+#ifndef Hadrons_DistilVectorSet_hpp_
+#define Hadrons_DistilVectorSet_hpp_
+
+#include <Hadrons/Global.hpp>
+#include <Hadrons/EigenPack.hpp>
+
+BEGIN_HADRONS_NAMESPACE
+
+/******************************************************************************
+ *          Time-slice local kernels on Laplacian eigenvectors                *
+ ******************************************************************************/
+// Both kernels work on the local volume in a single pass over the sites, the
+// time slices held in the SIMD lanes being handled with per-lane
+// coefficients. No 3D grid or slice extraction is involved. The threads share
+// all the outer sites, whatever the number of local time slices; the outer
+// time slice of site ss is (ss/ostride) % rd.
+//
+// Blocked time-slice inner products <evec[k] | psi[b]_s>(t) for k < nvec, all
+// spins s and all the fields of the batch psi. res (size nb*nvec*Ns*Nt, layout
+// ((b*nvec + k)*Ns + s)*Nt + t) is accumulated into for the time slices owned
+// by this node, so that a single GlobalSumVector on the 4d grid completes the
+// reduction for the whole batch. Each eigenvector site is loaded once for the
+// whole batch; the per-thread partial sums take nb*nvec*Ns*rd SIMD vectors.
+template <typename FermionField>
+inline void localSliceInnerProductBlock(ComplexD *res,
+                                        const std::vector<LatticeColourVector> &evec,
+                                        const int nvec, 
+                                        const std::vector<const FermionField *> &psi)
+{
+    typedef typename FermionField::vector_object::scalar_type Scalar;
+    typedef typename FermionField::vector_type                Vector;
+    typedef decltype(evec[0].View(CpuRead))                   EvecView;
+    typedef decltype(psi[0]->View(CpuRead))                   PsiView;
+
+    GridBase                                      *grid = psi[0]->Grid();
+    const int                                     nb = psi.size();
+    const int                                     nd{grid->_ndimension};
+    const int                                     tdir{nd - 1};
+    const int                                     Nsimd{grid->Nsimd()};
+    const int                                     fd{grid->_fdimensions[tdir]};
+    const int                                     ld{grid->_ldimensions[tdir]};
+    const int                                     rd{grid->_rdimensions[tdir]};
+    const int                                     ostride{grid->_ostride[tdir]};
+    const int                                     tFirst{grid->_processor_coor[tdir]*ld};
+    const int                                     osites{grid->oSites()};
+    const int                                     nSum{nb*nvec*Ns*rd};
+    const int                                     nthread{GridThread::GetThreads()};
+    std::vector<Vector, alignedAllocator<Vector>> lvSum(nthread*nSum);
+    std::vector<EvecView>                         evec_v;
+    std::vector<PsiView>                          psi_v;
+
+    for (int k = 0; k < nvec; k++)
+    {
+        evec_v.push_back(evec[k].View(CpuRead));
+    }
+    for (int b = 0; b < nb; b++)
+    {
+        psi_v.push_back(psi[b]->View(CpuRead));
+    }
+    thread_for(thr, nthread,
+    {
+        int    mywork, myoff;
+        Vector *sum = &lvSum[thr*nSum];
+
+        GridThread::GetWork(osites, thr, mywork, myoff);
+        for (int i = 0; i < nSum; i++)
+        {
+            sum[i] = Zero();
+        }
+        for (int ss = myoff; ss < myoff + mywork; ss++)
+        {
+            const int r{(ss/ostride) % rd};
+
+            for (int k = 0; k < nvec; k++)
+            {
+                const auto evec_s = evec_v[k][ss];
+
+                for (int b = 0; b < nb; b++)
+                {
+                    const auto psi_s = psi_v[b][ss];
+
+                    for (int s = 0; s < Ns; s++)
+                    {
+                        sum[((b*nvec + k)*Ns + s)*rd + r] +=
+                            TensorRemove(innerProduct(evec_s()(), psi_s()(s)));
+                    }
+                }
+            }
+        }
+    });
+    for (auto &v: evec_v)
+    {
+        v.ViewClose();
+    }
+    for (auto &v: psi_v)
+    {
+        v.ViewClose();
+    }
+    // reduce the per-thread partial sums
+    thread_for(i, nSum,
+    {
+        for (int thr = 1; thr < nthread; thr++)
+        {
+            lvSum[i] += lvSum[thr*nSum + i];
+        }
+    });
+
+    Coordinate icoor(nd);
+
+    for (int i = 0; i < nb*nvec*Ns; i++)
+    for (int r = 0; r < rd; r++)
+    {
+        const Scalar *lane = reinterpret_cast<const Scalar *>(&lvSum[i*rd + r]);
+
+        for (int idx = 0; idx < Nsimd; idx++)
+        {
+            grid->iCoorFromIindex(icoor, idx);
+            res[i*fd + tFirst + r + icoor[tdir]*rd] += static_cast<ComplexD>(lane[idx]);
+        }
+    }
+}
+
+// single field version, res has size nvec*Ns*Nt and layout (k*Ns + s)*Nt + t
+template <typename FermionField>
+inline void localSliceInnerProductBlock(ComplexD *res,
+                                        const std::vector<LatticeColourVector> &evec,
+                                        const int nvec, const FermionField &psi)
+{
+    localSliceInnerProductBlock(res, evec, nvec, 
+                                std::vector<const FermionField *>{&psi});
+}
+
+// Time-slice linear combination
+//   res(x, t) = sum_k evec[k](x, t) coef[t*nvec + k]
+// for k < nvec, with spin-vector coefficients indexed by the global time t.
+// Time slices with vanishing coefficients are zeroed without any evec access.
+template <typename FermionField>
+inline void localSliceLinearCombination(FermionField &res,
+                                        const std::vector<LatticeColourVector> &evec,
+                                        const int nvec, const SpinVector *coef)
+{
+    typedef typename FermionField::vector_object        vobj;
+    typedef typename vobj::scalar_type                  Scalar;
+    typedef typename vobj::vector_type                  Vector;
+    typedef iSpinVector<Scalar>                         sCoef;
+    typedef iSpinVector<Vector>                         vCoef;
+    typedef decltype(evec[0].View(CpuRead))             EvecView;
+
+    GridBase                                    *grid = res.Grid();
+    const int                                   nd{grid->_ndimension};
+    const int                                   tdir{nd - 1};
+    const int                                   Nsimd{grid->Nsimd()};
+    const int                                   ld{grid->_ldimensions[tdir]};
+    const int                                   rd{grid->_rdimensions[tdir]};
+    const int                                   ostride{grid->_ostride[tdir]};
+    const int                                   tFirst{grid->_processor_coor[tdir]*ld};
+    std::vector<vCoef, alignedAllocator<vCoef>> lvCoef(nvec*rd);
+    std::vector<int>                            nonZero(rd, 0);
+    ExtractBuffer<sCoef>                        buf(Nsimd);
+    std::vector<EvecView>                       evec_v;
+    Coordinate                                  icoor(nd);
+
+    for (int r = 0; r < rd; r++)
+    for (int k = 0; k < nvec; k++)
+    {
+        for (int idx = 0; idx < Nsimd; idx++)
+        {
+            grid->iCoorFromIindex(icoor, idx);
+
+            const SpinVector &c = coef[(tFirst + r + icoor[tdir]*rd)*nvec + k];
+
+            for (int s = 0; s < Ns; s++)
+            {
+                buf[idx]()(s)() = static_cast<Scalar>(c()(s)());
+                nonZero[r]     |= (c()(s)() != 0.);
+            }
+        }
+        merge(lvCoef[k*rd + r], buf);
+    }
+    for (int k = 0; k < nvec; k++)
+    {
+        evec_v.push_back(evec[k].View(CpuRead));
+    }
+    {
+        autoView(res_v, res, CpuWrite);
+        thread_for(ss, grid->oSites(),
+        {
+            const int r{(ss/ostride) % rd};
+            vobj      v = Zero();
+
+            if (nonZero[r])
+            {
+                for (int k = 0; k < nvec; k++)
+                {
+                    const auto evec_s = evec_v[k][ss];
+                    const auto &c     = lvCoef[k*rd + r];
+
+                    for (int s = 0; s < Ns; s++)
+                    for (int a = 0; a < Nc; a++)
+                    {
+                        v()(s)(a) += evec_s()()(a)*c()(s)();
+                    }
+                }
+            }
+            res_v[ss] = v;
+        });
+    }
+    for (auto &v: evec_v)
+    {
+        v.ViewClose();
+    }
+}
+
+/******************************************************************************
+ *                   Compact set of distillation vectors                      *
+ ******************************************************************************/
+// Every distillation vector (rho or phi) has the form
+//   v_i(x, t) = sum_k evec_k(x, t) C_i(t, k)
+// with spin-vector coefficients C_i(t, k). Only the coefficients are stored
+// (nvec x Nt per vector) and the 4D fields are expanded on demand, time slices
+// with vanishing coefficients are skipped.
+template <typename FImpl>
+class DistilVectorSet
+{
+public:
+    typedef typename FImpl::FermionField   FermionField;
+    typedef EigenPack<LatticeColourVector> LapPack;
+public:
+    // constructor/destructor
+    DistilVectorSet(const LapPack &epack, const int size, const int nvec,
+                    GridCartesian *grid);
+    virtual ~DistilVectorSet(void) = default;
+    // access
+    int          size(void) const;
+    int          nvec(void) const;
+    SpinVector & coef(const int i, const int t, const int k);
+    void         zero(void);
+    // expand vector i into f
+    void         expand(FermionField &f, const int i);
+    // expand vectors i .. i + n - 1 into buf[offset .. offset + n - 1]
+    void         expand(std::vector<FermionField> &buf, const int i,
+                        const unsigned int n, const unsigned int offset = 0);
+private:
+    const LapPack           *epack_;
+    int                     size_, nvec_, nt_;
+    std::vector<SpinVector> coef_;
+};
+
+/******************************************************************************
+ *                  DistilVectorSet template implementation                   *
+ ******************************************************************************/
+template <typename FImpl>
+DistilVectorSet<FImpl>::DistilVectorSet(const LapPack &epack, const int size,
+                                        const int nvec, GridCartesian *grid)
+: epack_(&epack), size_(size), nvec_(nvec)
+{
+    if (nvec_ > epack_->evec.size())
+    {
+        HADRONS_ERROR(Size, "distillation vector set needs " + std::to_string(nvec_)
+                      + " Laplacian eigenvectors, only "
+                      + std::to_string(epack_->evec.size()) + " available");
+    }
+    nt_ = grid->_gdimensions[grid->_ndimension - 1];
+    coef_.resize(size_*nt_*nvec_);
+    zero();
+}
+
+template <typename FImpl>
+int DistilVectorSet<FImpl>::size(void) const
+{
+    return size_;
+}
+
+template <typename FImpl>
+int DistilVectorSet<FImpl>::nvec(void) const
+{
+    return nvec_;
+}
+
+template <typename FImpl>
+SpinVector & DistilVectorSet<FImpl>::coef(const int i, const int t, const int k)
+{
+    return coef_[(i*nt_ + t)*nvec_ + k];
+}
+
+template <typename FImpl>
+void DistilVectorSet<FImpl>::zero(void)
+{
+    for (auto &c: coef_)
+    {
+        c = Zero();
+    }
+}
+
+template <typename FImpl>
+void DistilVectorSet<FImpl>::expand(FermionField &f, const int i)
+{
+    localSliceLinearCombination(f, epack_->evec, nvec_, &coef(i, 0, 0));
+}
+
+template <typename FImpl>
+void DistilVectorSet<FImpl>::expand(std::vector<FermionField> &buf, const int i,
+                                    const unsigned int n, const unsigned int offset)
+{
+    if (offset + n > buf.size())
+    {
+        HADRONS_ERROR(Size, "buffer too small for " + std::to_string(n)
+                      + " distillation vectors");
+    }
+    for (unsigned int k = 0; k < n; ++k)
+    {
+        expand(buf[offset + k], i + k);
+    }
+}
+
+END_HADRONS_NAMESPACE
+
+#endif // Hadrons_DistilVectorSet_hpp_
@@ -97,6 +97,52 @@ namespace EigenPackIo
         eval = vecRecord.eval;
     }
 
+    inline std::string elementFilename(const std::string filename, 
+                                       const unsigned int k)
+    {
+        if(filename.find("shuffle")!=std::string::npos){
+            // luchang's shuffled field writer
+            return filename + "/meta" + std::to_string(k) + ".txt";
+        }else{
+            // usual grid io
+            return filename + "/v" + std::to_string(k) + ".bin";
+        }
+    }
+
+    // processor grid of one I/O group when the ranks of grid are split in
+    // nGroups groups, the slowest dimensions are split first
+    inline Coordinate ioGroupProcessors(const GridBase *grid, 
+                                        const unsigned int nGroups)
+    {
+        Coordinate   proc = grid->_processors;
+        unsigned int n    = nGroups;
+
+        for (int d = proc.size() - 1; d >= 0; --d)
+        {
+            unsigned int f = 2;
+
+            while (f <= n)
+            {
+                if ((n % f == 0) and (proc[d] % f == 0))
+                {
+                    proc[d] /= f;
+                    n       /= f;
+                }
+                else
+                {
+                    f++;
+                }
+            }
+        }
+        if (n != 1)
+        {
+            HADRONS_ERROR(Size, "cannot split processor grid in " 
+                          + std::to_string(nGroups) + " I/O groups");
+        }
+
+        return proc;
+    }
+
     template <typename T, typename TIo = T>
     static void readPack(std::vector<T> &evec, std::vector<RealD> &eval,
                          PackRecord &record, const std::string filename, 
@@ -117,17 +163,9 @@ namespace EigenPackIo
         }
         if (multiFile)
         {
-            std::string fullFilename;
             for(int k = 0; k < size; ++k) 
             {
-                if(filename.find("shuffle")!=std::string::npos){
-                    // luchang's shuffled field writer
-                    fullFilename = filename + "/meta" + std::to_string(k) + ".txt";
-                }else{
-                    // usual grid io
-                    fullFilename = filename + "/v" + std::to_string(k) + ".bin";
-                }
-                binReader.open(fullFilename);
+                binReader.open(elementFilename(filename, k));
                 readHeader(record, binReader);
                 readElement(evec[k], eval[k], k, binReader, ioBuf.get());
                 
@@ -156,6 +194,121 @@ namespace EigenPackIo
         }
     }
 
+    // multi-file read where the ranks are split in nGroups I/O groups, each
+    // group reads a different file on its own sub-communicator and the fields
+    // are then redistributed to the full processor grid. The split red-black
+    // grids use the checkerboarding of the pack grid (e.g. 5D red-black grids
+    // are checkerboarded along dimension 1), so the unsplit is site to site.
+    template <typename T, typename TIo = T>
+    static void readPackGroups(std::vector<T> &evec, std::vector<RealD> &eval,
+                               PackRecord &record, const std::string filename, 
+                               const unsigned int size, const unsigned int nGroups,
+                               GridCartesian *grid, GridCartesian *gridIo = nullptr)
+    {
+        GridBase                               *full = evec[0].Grid();
+        auto                                   *fullRb = dynamic_cast<GridRedBlackCartesian *>(full);
+        Coordinate                             proc = ioGroupProcessors(grid, nGroups);
+        int                                    group, groupIo;
+        GridCartesian                          splitGrid(grid->FullDimensions(),
+                                                         grid->_simd_layout,
+                                                         proc, *grid, group);
+        std::unique_ptr<GridRedBlackCartesian> splitRbGrid{nullptr};
+        GridBase                               *split = &splitGrid;
+        std::unique_ptr<GridCartesian>         splitGridIo{nullptr};
+        std::unique_ptr<GridRedBlackCartesian> splitRbGridIo{nullptr};
+        std::unique_ptr<TIo>                   ioBuf{nullptr};
+        std::vector<T>                         groupVec;
+        ScidacReader                           binReader;
+
+        if (full->_isCheckerBoarded)
+        {
+            if (fullRb == nullptr)
+            {
+                HADRONS_ERROR(Definition, "checkerboarded eigenpack grid is not red-black");
+            }
+            splitRbGrid.reset(new GridRedBlackCartesian(&splitGrid, 
+                                                        fullRb->_checker_dim_mask,
+                                                        fullRb->_checker_dim));
+            split = splitRbGrid.get();
+        }
+        if (typeHash<T>() != typeHash<TIo>())
+        {
+            if (gridIo == nullptr)
+            {
+                HADRONS_ERROR(Definition, 
+                              "I/O type different from vector type but null I/O grid passed");
+            }
+            splitGridIo.reset(new GridCartesian(gridIo->FullDimensions(),
+                                                gridIo->_simd_layout,
+                                                proc, *gridIo, groupIo));
+            if (fullRb)
+            {
+                splitRbGridIo.reset(new GridRedBlackCartesian(splitGridIo.get(),
+                                                              fullRb->_checker_dim_mask,
+                                                              fullRb->_checker_dim));
+                ioBuf.reset(new TIo(splitRbGridIo.get()));
+            }
+            else
+            {
+                ioBuf.reset(new TIo(splitGridIo.get()));
+            }
+        }
+
+        T buf(split);
+
+        LOG(Message) << "Reading " << size << " eigenvectors with " << nGroups
+                     << " I/O groups (group processor grid " << proc << ")" 
+                     << std::endl;
+        for (auto &e: eval)
+        {
+            e = 0.;
+        }
+        // the unsplit writes directly into the pack vectors, which are moved
+        // in and out of groupVec; only the last pass may need padding fields
+        // when size is not a multiple of nGroups
+        groupVec.reserve(nGroups);
+        for (unsigned int k0 = 0; k0 < size; k0 += nGroups)
+        {
+            unsigned int k = k0 + group;
+
+            if (k < size)
+            {
+                binReader.open(elementFilename(filename, k));
+                readHeader(record, binReader);
+                readElement(buf, eval[k], k, binReader, ioBuf.get());
+                binReader.close();
+            }
+            else
+            {
+                buf = Zero();
+            }
+            groupVec.clear();
+            for (unsigned int g = 0; g < nGroups; ++g)
+            {
+                if (k0 + g < size)
+                {
+                    groupVec.push_back(std::move(evec[k0 + g]));
+                }
+                else
+                {
+                    groupVec.emplace_back(full);
+                }
+                groupVec.back().Checkerboard() = buf.Checkerboard();
+            }
+            Grid_unsplit(groupVec, buf);
+            for (unsigned int g = 0; (g < nGroups) and (k0 + g < size); ++g)
+            {
+                evec[k0 + g] = std::move(groupVec[g]);
+            }
+        }
+        // each eigenvalue was only read by the ranks of one group
+        grid->GlobalSumVector(eval.data(), eval.size());
+        for (auto &e: eval)
+        {
+            e /= splitGrid._Nprocessors;
+        }
+    }
+
     inline void writeHeader(ScidacWriter &binWriter, PackRecord &record)
     {
         XmlWriter xmlWriter("", "eigenPackPar");
@@ -216,13 +369,7 @@ namespace EigenPackIo
 
             for(int k = 0; k < size; ++k) 
             {
-                if(filename.find("shuffle")!=std::string::npos){
-                    // luchang's shuffled field writer
-                    fullFilename = filename + "/meta" + std::to_string(k) + ".txt";
-                }else{
-                    // usual grid io
-                    fullFilename = filename + "/v" + std::to_string(k) + ".bin";
-                }
+                fullFilename = elementFilename(filename, k);
                 makeFileDir(fullFilename, grid);
                 binWriter.open(fullFilename);
                 writeHeader(binWriter, record);
@@ -271,6 +418,28 @@ public:
     }
 };
 
+// eigenvector access at working precision F. If the pack is stored at a lower
+// precision (e.g. LoadFermionEigenPackF), the vector is promoted in buf.
+template <typename F>
+inline const F & promoteEvec(const std::vector<F> &evec, const unsigned int i,
+                             F *buf = nullptr)
+{
+    return evec[i];
+}
+
+template <typename F, typename FLow>
+inline const F & promoteEvec(const std::vector<FLow> &evec, const unsigned int i,
+                             F *buf)
+{
+    if (buf == nullptr)
+    {
+        HADRONS_ERROR(Definition, "low-precision eigenvector but null promotion buffer passed");
+    }
+    precisionChange(*buf, evec[i]);
+
+    return *buf;
+}
+
 template <typename F, typename FIo = F>
 class EigenPack: public BaseEigenPack<F>
 {
@@ -304,6 +473,16 @@ public:
         HADRONS_DUMP_EP_METADATA(this->record);
     }
 
+    void readGroups(const std::string fileStem, const unsigned int nGroups,
+                    GridCartesian *grid, GridCartesian *gridIo = nullptr, 
+                    const int traj = -1)
+    {
+        EigenPackIo::readPackGroups<F, FIo>(this->evec, this->eval, this->record, 
+                                            evecFilename(fileStem, traj, true), 
+                                            this->evec.size(), nGroups, grid, gridIo);
+        HADRONS_DUMP_EP_METADATA(this->record);
+    }
+
     virtual void write(const std::string fileStem, const bool multiFile, const int traj = -1)
     {
         EigenPackIo::writePack<F, FIo>(evecFilename(fileStem, traj, multiFile), 
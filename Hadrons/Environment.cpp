@@ -92,6 +92,12 @@ GridSerialRNG * Environment::getSerialRng(void)
     return rngSerial_.get();
 }
 
+// FFT /////////////////////////////////////////////////////////////////////////
+FftService & Environment::getFft(void)
+{
+    return fft_;
+}
+
 // general memory management ///////////////////////////////////////////////////
 void Environment::addObject(const std::string name, const int moduleAddress)
 {
@@ -29,6 +29,7 @@
 #define Hadrons_Environment_hpp_
 
 #include <Hadrons/Global.hpp>
+#include <Hadrons/FftService.hpp>
 
 BEGIN_HADRONS_NAMESPACE
 
@@ -115,6 +116,8 @@ public:
     // random number generator
     GridParallelRNG *       get4dRng(void);
     GridSerialRNG *         getSerialRng(void);
+    // batched FFTs
+    FftService &            getFft(void);
     // general memory management
     void                    addObject(const std::string name,
                                       const int moduleAddress = -1);
@@ -189,6 +192,8 @@ private:
     // random number generator
     RngPt                               rng4d_{nullptr};
     SerialRngPt                         rngSerial_{nullptr};
+    // FFTs
+    FftService                          fft_;
     // object store
     std::vector<ObjInfo>                object_;
     std::map<std::string, unsigned int> objectAddress_;
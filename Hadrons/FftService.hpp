@@ -0,0 +1,305 @@
+/*
+ * FftService.hpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+#ifndef Hadrons_FftService_hpp_
+#define Hadrons_FftService_hpp_
+
+#include <Hadrons/Global.hpp>
+
+#ifndef HADRONS_FFT_BATCH
+#define HADRONS_FFT_BATCH 8
+#endif
+
+BEGIN_HADRONS_NAMESPACE
+
+/******************************************************************************
+ *                            Batched FFTs                                    *
+ ******************************************************************************/
+// The environment owns one FftService. It keeps one Grid FFT object per
+// (grid, dimension mask) for the whole run, so modules share them. Grid
+// creates and destroys the FFTW plans at every call, these are not cached.
+// The saving comes from batching: up to `batch` fields are packed as the
+// components of a single vector field, so that one multi-component FFT (one
+// set of FFTW plans and one set of transposes) replaces one FFT per field.
+// The packed fields are provided by the caller, so that modules can register
+// them as temporaries.
+class FftService
+{
+public:
+    // a batch of fields packed as the components of a vector field
+    template <typename Field, int batch = HADRONS_FFT_BATCH>
+    using PackedField = Lattice<iVector<typename Field::vector_object, batch>>;
+    class Transform
+    {
+    public:
+        // constructor
+        Transform(GridCartesian *grid, const std::vector<int> &mask);
+        // transform one field
+        template <typename Field>
+        void operator()(Field &out, const Field &in, const int sign);
+        // transform a set of fields, out and in can be the same fields,
+        // packed and packedFt are work fields
+        template <typename Field, int batch>
+        void operator()(const std::vector<Field *> &out,
+                        const std::vector<const Field *> &in, const int sign,
+                        PackedField<Field, batch> &packed,
+                        PackedField<Field, batch> &packedFt);
+        template <typename Field, int batch>
+        void operator()(std::vector<Field> &out, const std::vector<Field> &in,
+                        const int sign, PackedField<Field, batch> &packed,
+                        PackedField<Field, batch> &packedFt);
+        // number of single-field transforms done with this object
+        unsigned long int fieldCount(void) const;
+    private:
+        FFT               fft_;
+        std::vector<int>  mask_;
+        unsigned long int fieldCount_{0};
+    };
+    typedef std::pair<GridCartesian *, std::vector<int>> Key;
+public:
+    // get (and create if needed) the transform for a grid and dimension mask
+    Transform & getTransform(GridCartesian *grid, const std::vector<int> &mask);
+    // spatial FFT on the last dimension being time
+    Transform & getSpatialTransform(GridCartesian *grid);
+    // free all transforms
+    void        clear(void);
+    // values of momentum-space fields ft[i] at the spatial momenta mom[m] (in
+    // units of 2 pi/L, any sign) for all times, res[(i*nMom + m)*nt + t],
+    // gathered with a single global sum
+    template <typename Field>
+    static void gatherMomenta(std::vector<typename Field::scalar_object> &res,
+                              const std::vector<const Field *> &ft,
+                              const std::vector<std::vector<int>> &mom);
+private:
+    std::map<Key, std::unique_ptr<Transform>> transform_;
+};
+
+/******************************************************************************
+ *                      FftService implementation                             *
+ ******************************************************************************/
+inline FftService::Transform::Transform(GridCartesian *grid,
+                                       const std::vector<int> &mask)
+: fft_(grid), mask_(mask)
+{
+    if (mask_.size() != grid->_ndimension)
+    {
+        HADRONS_ERROR(Size, "FFT mask has " + std::to_string(mask_.size())
+                      + " dimensions instead of "
+                      + std::to_string(grid->_ndimension));
+    }
+}
+
+template <typename Field>
+void FftService::Transform::operator()(Field &out, const Field &in, const int sign)
+{
+    fft_.FFT_dim_mask(out, in, mask_, sign);
+    fieldCount_++;
+}
+
+template <typename Field, int batch>
+void FftService::Transform::operator()(const std::vector<Field *> &out,
+                                       const std::vector<const Field *> &in,
+                                       const int sign,
+                                       PackedField<Field, batch> &packed,
+                                       PackedField<Field, batch> &packedFt)
+{
+    if (out.size() != in.size())
+    {
+        HADRONS_ERROR(Size, "FFT input and output sets have different sizes");
+    }
+    if (in.size() == 0)
+    {
+        return;
+    }
+
+    GridBase *grid = in[0]->Grid();
+
+    if ((packed.Grid() != grid) or (packedFt.Grid() != grid))
+    {
+        HADRONS_ERROR(Size, "FFT work fields and input fields grids differ");
+    }
+
+    for (unsigned int i0 = 0; i0 < in.size(); i0 += batch)
+    {
+        const unsigned int nb = std::min(static_cast<unsigned int>(batch),
+                                         static_cast<unsigned int>(in.size() - i0));
+
+        if (nb == 1)
+        {
+            (*this)(*out[i0], *in[i0], sign);
+            continue;
+        }
+        {
+            autoView(p_v, packed, CpuWrite);
+            for (unsigned int b = 0; b < batch; ++b)
+            {
+                if (b < nb)
+                {
+                    autoView(in_v, *in[i0 + b], CpuRead);
+                    thread_for(ss, grid->oSites(),
+                    {
+                        p_v[ss](b) = in_v[ss];
+                    });
+                }
+                else
+                {
+                    thread_for(ss, grid->oSites(),
+                    {
+                        p_v[ss](b) = Zero();
+                    });
+                }
+            }
+        }
+        fft_.FFT_dim_mask(packedFt, packed, mask_, sign);
+        {
+            autoView(p_v, packedFt, CpuRead);
+            for (unsigned int b = 0; b < nb; ++b)
+            {
+                autoView(out_v, *out[i0 + b], CpuWrite);
+                thread_for(ss, grid->oSites(),
+                {
+                    out_v[ss] = p_v[ss](b);
+                });
+            }
+        }
+        fieldCount_ += nb;
+    }
+}
+
+template <typename Field, int batch>
+void FftService::Transform::operator()(std::vector<Field> &out,
+                                       const std::vector<Field> &in,
+                                       const int sign,
+                                       PackedField<Field, batch> &packed,
+                                       PackedField<Field, batch> &packedFt)
+{
+    std::vector<Field *>       outPt;
+    std::vector<const Field *> inPt;
+
+    for (auto &f: out)
+    {
+        outPt.push_back(&f);
+    }
+    for (auto &f: in)
+    {
+        inPt.push_back(&f);
+    }
+    (*this)(outPt, inPt, sign, packed, packedFt);
+}
+
+inline unsigned long int FftService::Transform::fieldCount(void) const
+{
+    return fieldCount_;
+}
+
+inline FftService::Transform & FftService::getTransform(GridCartesian *grid,
+                                                        const std::vector<int> &mask)
+{
+    Key key(grid, mask);
+    auto it = transform_.find(key);
+
+    if (it == transform_.end())
+    {
+        it = transform_.emplace(key, std::unique_ptr<Transform>(new Transform(grid, mask))).first;
+    }
+
+    return *(it->second);
+}
+
+inline FftService::Transform & FftService::getSpatialTransform(GridCartesian *grid)
+{
+    std::vector<int> mask(grid->_ndimension, 1);
+
+    mask.back() = 0;
+
+    return getTransform(grid, mask);
+}
+
+inline void FftService::clear(void)
+{
+    transform_.clear();
+}
+
+template <typename Field>
+void FftService::gatherMomenta(std::vector<typename Field::scalar_object> &res,
+                               const std::vector<const Field *> &ft,
+                               const std::vector<std::vector<int>> &mom)
+{
+    typedef typename Field::scalar_object sobj;
+    typedef typename Field::scalar_type   Scalar;
+
+    if (ft.size() == 0)
+    {
+        res.clear();
+        return;
+    }
+
+    GridBase           *grid  = ft[0]->Grid();
+    const unsigned int nd     = grid->_ndimension;
+    const unsigned int nt     = grid->_fdimensions[nd - 1];
+    const unsigned int nMom   = mom.size();
+    Coordinate         start  = grid->LocalStarts();
+    Coordinate         ldim   = grid->LocalDimensions();
+    Coordinate         qt(nd), lcoor(nd);
+    sobj               buf;
+
+    res.resize(ft.size()*nMom*nt);
+    for (auto &x: res)
+    {
+        x = Zero();
+    }
+    for (unsigned int m = 0; m < nMom; ++m)
+    {
+        for (unsigned int mu = 0; mu < nd - 1; ++mu)
+        {
+            const int l = grid->_fdimensions[mu];
+
+            qt[mu] = ((mom[m][mu] % l) + l) % l;
+        }
+        for (unsigned int t = 0; t < nt; ++t)
+        {
+            bool isLocal = true;
+
+            qt[nd - 1] = t;
+            for (unsigned int mu = 0; mu < nd; ++mu)
+            {
+                lcoor[mu] = qt[mu] - start[mu];
+                isLocal   = isLocal and (lcoor[mu] >= 0) and (lcoor[mu] < ldim[mu]);
+            }
+            if (isLocal)
+            {
+                for (unsigned int i = 0; i < ft.size(); ++i)
+                {
+                    peekLocalSite(buf, *ft[i], lcoor);
+                    res[(i*nMom + m)*nt + t] = buf;
+                }
+            }
+        }
+    }
+    grid->GlobalSumVector(reinterpret_cast<Scalar *>(res.data()),
+                          res.size()*sizeof(sobj)/sizeof(Scalar));
+}
+
+END_HADRONS_NAMESPACE
+
+#endif // Hadrons_FftService_hpp_
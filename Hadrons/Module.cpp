@@ -137,3 +137,20 @@ GridSerialRNG & ModuleBase::rngSerial(void)
 
     return r;
 }
+
+uint64_t ModuleBase::counterSeed(void)
+{
+    // FNV-1a hash, portable across compilers unlike std::hash
+    std::string seed = makeSeedString() + "-" + getName();
+    uint64_t    h    = 0xcbf29ce484222325ULL;
+
+    for (unsigned char c: seed)
+    {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    LOG(Message) << "Counter-based seed from string '" << seed << "': "
+                 << h << std::endl;
+
+    return h;
+}
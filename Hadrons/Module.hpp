@@ -205,6 +205,8 @@ protected:
     // get RNGs seeded from module string
     GridParallelRNG &rng4d(void);
     GridSerialRNG &rngSerial(void);
+    // 64-bit seed for counter-based generators, unique to module and trajectory
+    uint64_t counterSeed(void);
     // result file utilities
     std::string resultFilename(const std::string stem, const std::string ext = resultFileExt) const;
     template <typename T>
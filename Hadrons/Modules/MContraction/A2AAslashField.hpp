@@ -45,6 +45,7 @@ public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(A2AAslashFieldPar,
                                     int, cacheBlock,
                                     int, block,
+                                    bool, tune,
                                     std::string, left,
                                     std::string, right,
                                     std::string, output,
@@ -261,6 +262,11 @@ void TA2AAslashField<FImpl, PhotonImpl>::execute(void)
     Kernel kernel(B0, B1, envGetGrid(FermionField));
 
     envGetTmp(Computation, computation);
+    if (par().tune)
+    {
+        computation.tune(vm().getModuleType(getName()), left, right, kernel,
+                         vm().getMemoryBudget(), vm().getDatabase());
+    }
     computation.execute(left, right, kernel, ionameFn, filenameFn, metadataFn);
 #endif
 }
@@ -33,6 +33,7 @@
 #include <Hadrons/Module.hpp>
 #include <Hadrons/ModuleFactory.hpp>
 #include <Hadrons/A2AMatrix.hpp>
+#include <Hadrons/DistilVectorSet.hpp>
 
 BEGIN_HADRONS_NAMESPACE
 
@@ -47,6 +48,7 @@ public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(A2AMesonFieldPar,
                                     int, cacheBlock,
                                     int, block,
+                                    bool, tune,
                                     std::string, left,
                                     std::string, right,
                                     std::string, output,
@@ -140,6 +142,7 @@ public:
                                       A2AMesonFieldMetadata, 
                                       HADRONS_A2AM_IO_TYPE> Computation;
     typedef MesonFieldKernel<Complex, FImpl> Kernel;
+    typedef DistilVectorSet<FImpl>           VectorSet;
 public:
     // constructor
     TA2AMesonField(const std::string name);
@@ -152,8 +155,13 @@ public:
     virtual void setup(void);
     // execution
     virtual void execute(void);
+private:
+    unsigned int vectorCount(const std::string name);
+    void         fillVectors(const std::string name, std::vector<FermionField> &buf,
+                             const unsigned int i, const unsigned int n);
 private:
     bool                               hasPhase_{false};
+    bool                               compact_{false};
     std::string                        momphName_;
     std::vector<Gamma::Algebra>        gamma_;
     std::vector<std::vector<Real>>     mom_;
@@ -238,18 +246,59 @@ void TA2AMesonField<FImpl>::setup(void)
     envTmp(Computation, "computation", 1, envGetGrid(FermionField), 
            env().getNd() - 1, mom_.size(), gamma_.size(), par().block, 
            par().cacheBlock, this);
+    // compact distillation vectors are expanded block by block
+    compact_ = envHasType(VectorSet, par().left) 
+               or envHasType(VectorSet, par().right);
+    if (compact_)
+    {
+        envTmp(std::vector<FermionField>, "leftBuf", 1, par().block, 
+               envGetGrid(FermionField));
+        envTmp(std::vector<FermionField>, "rightBuf", 1, par().block, 
+               envGetGrid(FermionField));
+    }
+}
+
+template <typename FImpl>
+unsigned int TA2AMesonField<FImpl>::vectorCount(const std::string name)
+{
+    if (envHasType(VectorSet, name))
+    {
+        return envGet(VectorSet, name).size();
+    }
+    else
+    {
+        return envGet(std::vector<FermionField>, name).size();
+    }
+}
+
+template <typename FImpl>
+void TA2AMesonField<FImpl>::fillVectors(const std::string name, 
+                                        std::vector<FermionField> &buf,
+                                        const unsigned int i, 
+                                        const unsigned int n)
+{
+    if (envHasType(VectorSet, name))
+    {
+        envGet(VectorSet, name).expand(buf, i, n);
+    }
+    else
+    {
+        auto &vec = envGet(std::vector<FermionField>, name);
+
+        for (unsigned int k = 0; k < n; ++k)
+        {
+            buf[k] = vec[i + k];
+        }
+    }
 }
 
 // execution ///////////////////////////////////////////////////////////////////
 template <typename FImpl>
 void TA2AMesonField<FImpl>::execute(void)
 {
-    auto &left  = envGet(std::vector<FermionField>, par().left);
-    auto &right = envGet(std::vector<FermionField>, par().right);
-
     int nt         = env().getDim().back();
-    int N_i        = left.size();
-    int N_j        = right.size();
+    int N_i        = vectorCount(par().left);
+    int N_j        = vectorCount(par().right);
     int ngamma     = gamma_.size();
     int nmom       = mom_.size();
     int block      = par().block;
@@ -334,7 +383,55 @@ void TA2AMesonField<FImpl>::execute(void)
     Kernel      kernel(gamma_, ph, envGetGrid(FermionField));
 
     envGetTmp(Computation, computation);
-    computation.execute(left, right, kernel, ionameFn, filenameFn, metadataFn);
+    if (compact_)
+    {
+        auto leftFn = [this](std::vector<FermionField> &buf, const unsigned int i,
+                             const unsigned int n)
+        {
+            fillVectors(par().left, buf, i, n);
+        };
+        auto rightFn = [this](std::vector<FermionField> &buf, const unsigned int i,
+                              const unsigned int n)
+        {
+            fillVectors(par().right, buf, i, n);
+        };
+
+        envGetTmp(std::vector<FermionField>, leftBuf);
+        envGetTmp(std::vector<FermionField>, rightBuf);
+        if (par().tune)
+        {
+            // trial kernels on the first vectors, the blocks cannot exceed 
+            // the vector buffers
+            const unsigned int n_i = std::min(N_i, block);
+            const unsigned int n_j = std::min(N_j, block);
+
+            auto trial = [&](A2AMatrixSet<Complex> &m, const unsigned int, 
+                             const unsigned int, double &t)
+            {
+                kernel(m, leftBuf.data(), rightBuf.data(), env().getNd() - 1, t);
+            };
+
+            fillVectors(par().left, leftBuf, 0, n_i);
+            fillVectors(par().right, rightBuf, 0, n_j);
+            computation.tune(vm().getModuleType(getName()), N_i, N_j, block, 
+                             kernel, trial, vm().getMemoryBudget(), 
+                             vm().getDatabase());
+        }
+        computation.execute(N_i, N_j, leftBuf, rightBuf, leftFn, rightFn, kernel,
+                            ionameFn, filenameFn, metadataFn);
+    }
+    else
+    {
+        auto &left  = envGet(std::vector<FermionField>, par().left);
+        auto &right = envGet(std::vector<FermionField>, par().right);
+
+        if (par().tune)
+        {
+            computation.tune(vm().getModuleType(getName()), left, right, kernel,
+                             vm().getMemoryBudget(), vm().getDatabase());
+        }
+        computation.execute(left, right, kernel, ionameFn, filenameFn, metadataFn);
+    }
 }
 
 END_MODULE_NAMESPACE
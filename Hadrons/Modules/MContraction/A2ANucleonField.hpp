@@ -54,7 +54,8 @@ public:
                                     std::string, q3,
                                     std::string, output,
                                     std::string, gammas, // may not need this for 2pt
-                                    std::vector<std::string>, mom);
+                                    std::vector<std::string>, mom,
+                                    bool, distributeTime);
 };
 
 class A2ANucleonFieldMetadata: Serializable
@@ -219,7 +220,7 @@ void TA2ANucleonField<FImpl>::setup(void)
     envTmpLat(ComplexField, "coor");
     envTmp(Computation, "computation", 1, envGetGrid(FermionField), 
            env().getNd() - 1, mom_.size(), Ns, par().block, 
-           par().cacheBlock, this);
+           par().cacheBlock, this, par().distributeTime);
 }
 
 // execution ///////////////////////////////////////////////////////////////////
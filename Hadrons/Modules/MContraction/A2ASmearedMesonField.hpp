@@ -46,6 +46,7 @@ public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(A2ASmearedMesonFieldPar,
                                     int, cacheBlock,
                                     int, block,
+                                    bool, tune,
                                     std::string, left,
                                     std::string, right,
                                     std::string, distributions,
@@ -430,6 +431,11 @@ void TA2ASmearedMesonField<FImpl>::execute(void)
     Kernel kernel(gamma_, smear_weight, envGetGrid(FermionField));
 
     envGetTmp(Computation, computation);
+    if (par().tune)
+    {
+        computation.tune(vm().getModuleType(getName()), left, right, kernel,
+                         vm().getMemoryBudget(), vm().getDatabase());
+    }
     computation.execute(left, right, kernel, ionameFn, filenameFn, metadataFn);
 }
 
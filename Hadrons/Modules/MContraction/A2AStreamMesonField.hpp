@@ -0,0 +1,396 @@
+/*
+ * A2AStreamMesonField.hpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+#ifndef Hadrons_MContraction_A2AStreamMesonField_hpp_
+#define Hadrons_MContraction_A2AStreamMesonField_hpp_
+
+#include <Hadrons/Global.hpp>
+#include <Hadrons/Module.hpp>
+#include <Hadrons/ModuleFactory.hpp>
+#include <Hadrons/Solver.hpp>
+#include <Hadrons/EigenPack.hpp>
+#include <Hadrons/A2AVectors.hpp>
+#include <Hadrons/A2AMatrix.hpp>
+#include <Hadrons/DilutedNoise.hpp>
+#include <Hadrons/Modules/MContraction/A2AMesonField.hpp>
+
+BEGIN_HADRONS_NAMESPACE
+
+/******************************************************************************
+ *     All-to-all meson field from A2A vectors generated block by block       *
+ ******************************************************************************/
+// The W & V vectors are built as in MSolver::A2AVectors, one block at a time,
+// and contracted straight away. V blocks are generated once, W blocks are
+// regenerated for each V block (W low modes are cheap, high modes are copies
+// of the noise). Only 2*block fermion fields are kept in memory.
+BEGIN_MODULE_NAMESPACE(MContraction)
+
+class A2AStreamMesonFieldPar: Serializable
+{
+public:
+    GRID_SERIALIZABLE_CLASS_MEMBERS(A2AStreamMesonFieldPar,
+                                    std::string, noise,
+                                    std::string, action,
+                                    std::string, eigenPack,
+                                    std::string, solver,
+                                    int, cacheBlock,
+                                    int, block,
+                                    std::string, output,
+                                    std::string, gammas,
+                                    std::vector<std::string>, mom);
+};
+
+template <typename FImpl, typename Pack>
+class TA2AStreamMesonField : public Module<A2AStreamMesonFieldPar>
+{
+public:
+    FERM_TYPE_ALIASES(FImpl,);
+    SOLVER_TYPE_ALIASES(FImpl,);
+    typedef HADRONS_DEFAULT_SCHUR_A2A<FImpl> A2A;
+    typedef A2AMatrixBlockComputation<Complex,
+                                      FermionField,
+                                      A2AMesonFieldMetadata,
+                                      HADRONS_A2AM_IO_TYPE> Computation;
+    typedef MesonFieldKernel<Complex, FImpl> Kernel;
+public:
+    // constructor
+    TA2AStreamMesonField(const std::string name);
+    // destructor
+    virtual ~TA2AStreamMesonField(void) {};
+    // dependency relation
+    virtual std::vector<std::string> getInput(void);
+    virtual std::vector<std::string> getOutput(void);
+    // setup
+    virtual void setup(void);
+    // execution
+    virtual void execute(void);
+private:
+    bool                               hasPhase_{false};
+    std::string                        momphName_;
+    std::vector<Gamma::Algebra>        gamma_;
+    std::vector<std::vector<Real>>     mom_;
+    unsigned int                       Nl_{0};
+};
+
+MODULE_REGISTER_TMP(A2AStreamMesonField,
+    ARG(TA2AStreamMesonField<FIMPL, BaseFermionEigenPack<FIMPL>>), MContraction);
+
+/******************************************************************************
+ *                  TA2AStreamMesonField implementation                       *
+ ******************************************************************************/
+// constructor /////////////////////////////////////////////////////////////////
+template <typename FImpl, typename Pack>
+TA2AStreamMesonField<FImpl, Pack>::TA2AStreamMesonField(const std::string name)
+: Module<A2AStreamMesonFieldPar>(name)
+, momphName_(name + "_momph")
+{}
+
+// dependencies/products ///////////////////////////////////////////////////////
+template <typename FImpl, typename Pack>
+std::vector<std::string> TA2AStreamMesonField<FImpl, Pack>::getInput(void)
+{
+    std::string              sub_string;
+    std::vector<std::string> in;
+
+    if (!par().eigenPack.empty())
+    {
+        in.push_back(par().eigenPack);
+        sub_string = "_subtract";
+    }
+    in.push_back(par().solver + sub_string);
+    in.push_back(par().noise);
+
+    return in;
+}
+
+template <typename FImpl, typename Pack>
+std::vector<std::string> TA2AStreamMesonField<FImpl, Pack>::getOutput(void)
+{
+    std::vector<std::string> out = {};
+
+    return out;
+}
+
+// setup ///////////////////////////////////////////////////////////////////////
+template <typename FImpl, typename Pack>
+void TA2AStreamMesonField<FImpl, Pack>::setup(void)
+{
+    bool        hasLowModes = (!par().eigenPack.empty());
+    std::string sub_string  = (hasLowModes) ? "_subtract" : "";
+    auto        &noise      = envGet(SpinColorDiagonalNoise<FImpl>, par().noise);
+    auto        &action     = envGet(FMat, par().action);
+    auto        &solver     = envGet(Solver, par().solver + sub_string);
+    int         Ls          = env().getObjectLs(par().action);
+    int         N;
+
+    gamma_.clear();
+    mom_.clear();
+    if (par().gammas == "all")
+    {
+        gamma_ = {
+            Gamma::Algebra::Gamma5,
+            Gamma::Algebra::Identity,
+            Gamma::Algebra::GammaX,
+            Gamma::Algebra::GammaY,
+            Gamma::Algebra::GammaZ,
+            Gamma::Algebra::GammaT,
+            Gamma::Algebra::GammaXGamma5,
+            Gamma::Algebra::GammaYGamma5,
+            Gamma::Algebra::GammaZGamma5,
+            Gamma::Algebra::GammaTGamma5,
+            Gamma::Algebra::SigmaXY,
+            Gamma::Algebra::SigmaXZ,
+            Gamma::Algebra::SigmaXT,
+            Gamma::Algebra::SigmaYZ,
+            Gamma::Algebra::SigmaYT,
+            Gamma::Algebra::SigmaZT
+        };
+    }
+    else
+    {
+        gamma_ = strToVec<Gamma::Algebra>(par().gammas);
+    }
+    for (auto &pstr: par().mom)
+    {
+        auto p = strToVec<Real>(pstr);
+
+        if (p.size() != env().getNd() - 1)
+        {
+            HADRONS_ERROR(Size, "Momentum has " + std::to_string(p.size())
+                                + " components instead of "
+                                + std::to_string(env().getNd() - 1));
+        }
+        mom_.push_back(p);
+    }
+    if (hasLowModes)
+    {
+        auto &epack = envGet(Pack, par().eigenPack);
+
+        Nl_ = epack.evec.size();
+    }
+    N = Nl_ + noise.fermSize();
+    if (N < par().block)
+    {
+        HADRONS_ERROR(Range, "blockSize must not exceed number of A2A vectors.");
+    }
+    envCache(std::vector<ComplexField>, momphName_, 1,
+             par().mom.size(), envGetGrid(ComplexField));
+    envTmpLat(ComplexField, "coor");
+    envTmp(std::vector<FermionField>, "w", 1, par().block, envGetGrid(FermionField));
+    envTmp(std::vector<FermionField>, "v", 1, par().block, envGetGrid(FermionField));
+    if (Ls > 1)
+    {
+        envTmpLat(FermionField, "f5", Ls);
+    }
+    envTmp(A2A, "a2a", 1, action, solver);
+    envTmp(Computation, "computation", 1, envGetGrid(FermionField),
+           env().getNd() - 1, mom_.size(), gamma_.size(), par().block,
+           par().cacheBlock, this);
+}
+
+// execution ///////////////////////////////////////////////////////////////////
+template <typename FImpl, typename Pack>
+void TA2AStreamMesonField<FImpl, Pack>::execute(void)
+{
+    auto &noise = envGet(SpinColorDiagonalNoise<FImpl>, par().noise);
+    auto &ph    = envGet(std::vector<ComplexField>, momphName_);
+    int  Ls     = env().getObjectLs(par().action);
+    int  nt     = env().getDim().back();
+    int  N      = Nl_ + noise.fermSize();
+    int  nmom   = mom_.size();
+
+    const Pack *epack = nullptr;
+
+    if (Nl_ > 0)
+    {
+        epack = &envGet(Pack, par().eigenPack);
+    }
+    LOG(Message) << "Computing all-to-all meson fields from streamed A2A vectors"
+                 << std::endl;
+    if (Nl_ > 0)
+    {
+        LOG(Message) << "Eigenpack '" << par().eigenPack << "' (" << Nl_
+                     << " low modes) and noise '" << par().noise << "' ("
+                     << noise.fermSize() << " noise vectors)" << std::endl;
+    }
+    else
+    {
+        LOG(Message) << "Noise '" << par().noise << "' (" << noise.fermSize()
+                     << " noise vectors)" << std::endl;
+    }
+    LOG(Message) << "Momenta:" << std::endl;
+    for (auto &p: mom_)
+    {
+        LOG(Message) << "  " << p << std::endl;
+    }
+    LOG(Message) << "Spin bilinears:" << std::endl;
+    for (auto &g: gamma_)
+    {
+        LOG(Message) << "  " << g << std::endl;
+    }
+    LOG(Message) << "Meson field size: " << nt << "*" << N << "*" << N
+                 << " (filesize " << sizeString(nt*N*N*sizeof(HADRONS_A2AM_IO_TYPE))
+                 << "/momentum/bilinear)" << std::endl;
+
+    if (!hasPhase_)
+    {
+        startTimer("Momentum phases");
+        for (unsigned int j = 0; j < nmom; ++j)
+        {
+            Complex           i(0.0,1.0);
+            std::vector<Real> p;
+
+            envGetTmp(ComplexField, coor);
+            ph[j] = Zero();
+            for(unsigned int mu = 0; mu < mom_[j].size(); mu++)
+            {
+                LatticeCoordinate(coor, mu);
+                ph[j] = ph[j] + (mom_[j][mu]/env().getDim(mu))*coor;
+            }
+            ph[j] = exp((Real)(2*M_PI)*i*ph[j]);
+        }
+        hasPhase_ = true;
+        stopTimer("Momentum phases");
+    }
+
+    envGetTmp(A2A, a2a);
+
+    auto wFn = [this, &a2a, &noise, epack, Ls](std::vector<FermionField> &buf,
+                                               const unsigned int i,
+                                               const unsigned int n)
+    {
+        for (unsigned int k = 0; k < n; ++k)
+        {
+            unsigned int ind = i + k;
+
+            if (ind < Nl_)
+            {
+                if (Ls == 1)
+                {
+                    a2a.makeLowModeW(buf[k], epack->evec[ind], epack->eval[ind]);
+                }
+                else
+                {
+                    envGetTmp(FermionField, f5);
+                    a2a.makeLowModeW5D(buf[k], f5, epack->evec[ind], epack->eval[ind]);
+                }
+            }
+            else if (Ls != 1)
+            {
+                envGetTmp(FermionField, f5);
+                a2a.makeHighModeW5D(buf[k], f5, noise.getFerm(ind - Nl_));
+            }
+        }
+        // 4D high-mode W vectors are the diluted noise itself, fill them as a block
+        if ((Ls == 1) and (i + n > Nl_))
+        {
+            unsigned int first = std::max(i, Nl_);
+
+            noise.getFerm(buf, first - Nl_, i + n - first, first - i);
+        }
+    };
+
+    auto vFn = [this, &a2a, &noise, epack, Ls](std::vector<FermionField> &buf,
+                                               const unsigned int i,
+                                               const unsigned int n)
+    {
+        for (unsigned int k = 0; k < n; ++k)
+        {
+            unsigned int ind = i + k;
+
+            LOG(Message) << "V vector i = " << ind << " ("
+                         << ((ind < Nl_) ? "low mode" : "stochastic mode")
+                         << ")" << std::endl;
+            if (ind < Nl_)
+            {
+                if (Ls == 1)
+                {
+                    a2a.makeLowModeV(buf[k], epack->evec[ind], epack->eval[ind]);
+                }
+                else
+                {
+                    envGetTmp(FermionField, f5);
+                    a2a.makeLowModeV5D(buf[k], f5, epack->evec[ind], epack->eval[ind]);
+                }
+            }
+            else
+            {
+                if (Ls == 1)
+                {
+                    a2a.makeHighModeV(buf[k], noise.getFerm(ind - Nl_));
+                }
+                else
+                {
+                    envGetTmp(FermionField, f5);
+                    a2a.makeHighModeV5D(buf[k], f5, noise.getFerm(ind - Nl_));
+                }
+            }
+        }
+    };
+
+    auto ionameFn = [this](const unsigned int m, const unsigned int g)
+    {
+        std::stringstream ss;
+
+        ss << gamma_[g] << "_";
+        for (unsigned int mu = 0; mu < mom_[m].size(); ++mu)
+        {
+            ss << mom_[m][mu] << ((mu == mom_[m].size() - 1) ? "" : "_");
+        }
+
+        return ss.str();
+    };
+
+    auto filenameFn = [this, &ionameFn](const unsigned int m, const unsigned int g)
+    {
+        return par().output + "." + std::to_string(vm().getTrajectory())
+               + "/" + ionameFn(m, g) + ".h5";
+    };
+
+    auto metadataFn = [this](const unsigned int m, const unsigned int g)
+    {
+        A2AMesonFieldMetadata md;
+
+        for (auto pmu: mom_[m])
+        {
+            md.momentum.push_back(pmu);
+        }
+        md.gamma = gamma_[g];
+
+        return md;
+    };
+
+    Kernel kernel(gamma_, ph, envGetGrid(FermionField));
+
+    envGetTmp(std::vector<FermionField>, w);
+    envGetTmp(std::vector<FermionField>, v);
+    envGetTmp(Computation, computation);
+    computation.execute(N, N, w, v, wFn, vFn, kernel, ionameFn, filenameFn,
+                        metadataFn);
+}
+
+END_MODULE_NAMESPACE
+
+END_HADRONS_NAMESPACE
+
+#endif // Hadrons_MContraction_A2AStreamMesonField_hpp_
@@ -47,6 +47,106 @@ BEGIN_MODULE_NAMESPACE(MContraction)
 typedef std::pair<Gamma::Algebra, Gamma::Algebra> GammaAB;
 typedef std::pair<GammaAB, GammaAB> GammaABPair;
 
+/******************************************************************************
+ *                 Site-parallel baryon contraction kernel                    *
+ ******************************************************************************/
+// Evaluates the BaryonUtils site contraction directly on the SIMD site objects
+// (a one-element slice per outer site), i.e. the vectorised arithmetic of the
+// BaryonUtils lattice kernels. The outer sites are split between the threads,
+// each thread owning its one-site buffers, so no state is shared between
+// sites and the result does not depend on the number of threads. The Gamma
+// objects are built once per gamma structure at construction; the epsilon
+// tables are the static ones of BaryonUtils.
+template <typename FImpl>
+class BaryonKernel
+{
+public:
+    typedef typename FImpl::PropagatorField              PropagatorField;
+    typedef typename FImpl::ComplexField                 ComplexField;
+    typedef Lattice<iSpinMatrix<typename FImpl::Simd>>   SpinMatrixField;
+    typedef typename PropagatorField::vector_object      SitePropagator;
+public:
+    BaryonKernel(const GammaABPair &gamma, const int wickContractions,
+                 const int parity)
+    : gAl_(gamma.first.first), gBl_(gamma.first.second)
+    , gAr_(gamma.second.first), gBr_(gamma.second.second)
+    , wick_(wickContractions), parity_(parity)
+    {}
+
+    // parity-projected trace
+    void operator()(ComplexField &c, const PropagatorField &q1,
+                    const PropagatorField &q2, const PropagatorField &q3) const
+    {
+        typedef typename ComplexField::vector_object SiteComplex;
+
+        contract<SiteComplex>(c, q1, q2, q3, 
+                              [this](const SiteBuffer &d1, const SiteBuffer &d2,
+                                     const SiteBuffer &d3, 
+                                     std::vector<SiteComplex, alignedAllocator<SiteComplex>> &res)
+        {
+            BaryonUtils<FImpl>::ContractBaryonsSliced(d1, d2, d3,
+                                                      gAl_, gBl_, gAr_, gBr_,
+                                                      wick_, parity_, 1, res);
+        });
+    }
+
+    // full spin matrix, no parity projection
+    void operator()(SpinMatrixField &cMat, const PropagatorField &q1,
+                    const PropagatorField &q2, const PropagatorField &q3) const
+    {
+        typedef typename SpinMatrixField::vector_object SiteSpinMatrix;
+
+        contract<SiteSpinMatrix>(cMat, q1, q2, q3, 
+                                 [this](const SiteBuffer &d1, const SiteBuffer &d2,
+                                        const SiteBuffer &d3, 
+                                        std::vector<SiteSpinMatrix, alignedAllocator<SiteSpinMatrix>> &res)
+        {
+            BaryonUtils<FImpl>::ContractBaryonsSlicedMatrix(d1, d2, d3,
+                                                            gAl_, gBl_, gAr_, gBr_,
+                                                            wick_, 1, res);
+        });
+    }
+private:
+    typedef std::vector<SitePropagator, alignedAllocator<SitePropagator>> SiteBuffer;
+
+    // site loop shared by both contractions, site(d1, d2, d3, res) accumulates
+    // the contraction of the one-site buffers d1, d2, d3 into res[0]
+    template <typename SiteResult, typename ResultField, typename Site>
+    void contract(ResultField &c, const PropagatorField &q1, 
+                  const PropagatorField &q2, const PropagatorField &q3,
+                  Site &&site) const
+    {
+        GridBase  *grid = q1.Grid();
+        const int osites{grid->oSites()};
+        const int nthread{GridThread::GetThreads()};
+
+        autoView(q1_v, q1, CpuRead);
+        autoView(q2_v, q2, CpuRead);
+        autoView(q3_v, q3, CpuRead);
+        autoView(c_v, c, CpuWrite);
+        thread_for(thr, nthread,
+        {
+            int                                                   mywork, myoff;
+            SiteBuffer                                            d1(1), d2(1), d3(1);
+            std::vector<SiteResult, alignedAllocator<SiteResult>> res(1);
+
+            GridThread::GetWork(osites, thr, mywork, myoff);
+            for (int ss = myoff; ss < myoff + mywork; ss++)
+            {
+                d1[0]  = q1_v[ss];
+                d2[0]  = q2_v[ss];
+                d3[0]  = q3_v[ss];
+                res[0] = Zero();
+                site(d1, d2, d3, res);
+                c_v[ss] = res[0];
+            }
+        });
+    }
+private:
+    Gamma gAl_, gBl_, gAr_, gBr_;
+    int   wick_, parity_;
+};
+
 class BaryonPar: Serializable
 {
 public:
@@ -223,15 +323,6 @@ void TBaryon<FImpl>::setup(void)
 template <typename FImpl>
 void TBaryon<FImpl>::execute(void)
 {
-    //FIX Baryon utils!
-#ifdef GRID_OMP
-    std::cout << "setting "<< omp_get_num_threads() << " threads to 1\n" << std::endl;
-    int save_num_threads=omp_get_num_threads();
-    omp_set_num_threads(1);
-#else
-    std::cout << "Baryons: Single-threaded already\n" << std::endl;
-#endif
-    
     // Check shuffle is a permutation of "123"
     assert(par().shuffle.size()==3 && "shuffle parameter must be 3 characters long");
     std::string shuffle_tmp = par().shuffle;
@@ -329,10 +420,8 @@ void TBaryon<FImpl>::execute(void)
             rMat.info.gammaA_right = gammaList[i].second.first;
             rMat.info.gammaB_right = gammaList[i].second.second;
 
-            Gamma gAl(gammaList[i].first.first);
-            Gamma gBl(gammaList[i].first.second);
-            Gamma gAr(gammaList[i].second.first);
-            Gamma gBr(gammaList[i].second.second);
+            const BaryonKernel<FImpl> kernel(gammaList[i], wick_contractions,
+                                             par().parity);
         
             std::string ns = vm().getModuleNamespace(env().getObjectModule(par().sinkq1));
             if (ns == "MSource")
@@ -342,12 +431,7 @@ void TBaryon<FImpl>::execute(void)
                 if (par().trace) 
                 {
                     envGetTmp(LatticeComplex, c);
-                    c=Zero();
-                    BaryonUtils<FIMPL>::ContractBaryons(q1,q2,q3,
-                                                        gAl,gBl,gAr,gBr,
-                                                        wick_contractions,
-                                                        par().parity,
-                                                        c);
+                    kernel(c, q1, q2, q3);
 
                     auto test = closure(trace(sink*c));     
                     sliceSum(test, buf, Tp); 
@@ -355,11 +439,7 @@ void TBaryon<FImpl>::execute(void)
                 else 
                 {
                     envGetTmp(SpinMatrixField, cMat);
-                    cMat=Zero();
-                    BaryonUtils<FIMPL>::ContractBaryonsMatrix(q1,q2,q3,
-                                                        gAl,gBl,gAr,gBr,
-                                                        wick_contractions,
-                                                        cMat);
+                    kernel(cMat, q1, q2, q3);
                     cMat = cMat*sink;
 
                     sliceSum(cMat, bufMat, Tp);
@@ -370,12 +450,7 @@ void TBaryon<FImpl>::execute(void)
                 if (par().trace) 
                 {
                     envGetTmp(LatticeComplex, c);
-                    c=Zero();
-                    BaryonUtils<FIMPL>::ContractBaryons(q1,q2,q3,
-                                                        gAl,gBl,gAr,gBr,
-                                                        wick_contractions,
-                                                        par().parity,
-                                                        c);
+                    kernel(c, q1, q2, q3);
 
                     SinkFnScalar &sink = envGet(SinkFnScalar, par().sinkq1);
                     buf = sink(c);
@@ -383,11 +458,7 @@ void TBaryon<FImpl>::execute(void)
                 else 
                 {
                     envGetTmp(SpinMatrixField, cMat);
-                    cMat=Zero();
-                    BaryonUtils<FIMPL>::ContractBaryonsMatrix(q1,q2,q3,
-                                                        gAl,gBl,gAr,gBr,
-                                                        wick_contractions,
-                                                        cMat);
+                    kernel(cMat, q1, q2, q3);
 
                     SinkFnMat &sink = envGet(SinkFnMat, par().sinkq1);
                     bufMat = sink(cMat);
@@ -504,12 +575,6 @@ void TBaryon<FImpl>::execute(void)
         saveResult(par().output, "baryon", result);
     else 
         saveResult(par().output + "_Matrix", "baryonMat", resultMat);
-    
-    //FIX baryon utils!
-#ifdef GRID_OMP
-    omp_set_num_threads(save_num_threads);
-    std::cout << "set num threads back to "<< omp_get_num_threads() << std::endl;
-#endif
 
 }
 #endif
@@ -71,6 +71,7 @@ class TDiscLoop: public Module<DiscLoopPar>
 public:
     FERM_TYPE_ALIASES(FImpl,);
     typedef std::vector<SitePropagator> SlicedOp;
+    typedef FftService::PackedField<ComplexField> FftPackedField;
     class Result: Serializable
     {
     public:
@@ -153,8 +154,14 @@ void TDiscLoop<FImpl>::setup(void)
             mom_[i][j] = (mom_[i][j] + env().getDim(j)) % env().getDim(j);
         }
     }
-    envTmpLat(PropagatorField, "ftBuf");
-    envTmpLat(PropagatorField, "op");
+
+    std::vector<Gamma::Algebra> gammaList;
+
+    parseGammaString(gammaList);
+    envTmp(std::vector<ComplexField>, "op", 1, gammaList.size(),
+           envGetGrid(ComplexField));
+    envTmpLat(FftPackedField, "fftPacked");
+    envTmpLat(FftPackedField, "fftPackedFt");
 }
 
 template <typename FImpl>
@@ -187,19 +194,18 @@ void TDiscLoop<FImpl>::execute(void)
                  << "." << std::endl;
 
     const unsigned int                 nt      = env().getDim(Tp);
-    const unsigned int                 nd      = env().getDim().size();
     const unsigned int                 nmom    = mom_.size();
     auto                               &q_loop = envGet(PropagatorField, par().q_loop);
     std::vector<Gamma::Algebra>        gammaList;
-    SitePropagator                     buf;
-    std::vector<std::vector<SlicedOp>> slicedOp;
+    std::vector<typename ComplexField::scalar_object> buf;
+    std::vector<ComplexField *>        opPt;
+    std::vector<const ComplexField *>  ftPt;
     std::vector<std::vector<Result>>   result;
-    FFT                                fft(envGetGrid(PropagatorField));
-    std::vector<int>                   dMask(nd, 1);
+    auto &fft = env().getFft().getSpatialTransform(envGetGrid(ComplexField));
 
-    dMask[nd - 1] = 0;
-    envGetTmp(PropagatorField, ftBuf);
-    envGetTmp(PropagatorField, op);
+    envGetTmp(std::vector<ComplexField>, op);
+    envGetTmp(FftPackedField, fftPacked);
+    envGetTmp(FftPackedField, fftPackedFt);
     parseGammaString(gammaList);
     const unsigned int ngam = gammaList.size();
     result.resize(ngam);
@@ -214,32 +220,24 @@ void TDiscLoop<FImpl>::execute(void)
         }
     }
 
-    slicedOp.resize(ngam);
+    // the trace commutes with the FFT: only the traced loops are transformed,
+    // all gammas in one batch
     for (unsigned int g = 0; g < ngam; ++g)
     {
         Gamma gamma(gammaList[g]);
-        op = gamma*q_loop;
-        fft.FFT_dim_mask(ftBuf, op, dMask, FFT::forward);
-        slicedOp[g].resize(nmom);
-        for (unsigned int m = 0; m < nmom; ++m)
-        {
-            auto qt = mom_[m];
-            qt.resize(nd);
-            slicedOp[g][m].resize(nt);
-            for (unsigned int t = 0; t < nt; ++t)
-            {
-                qt[nd - 1] = t;
-                peekSite(buf, ftBuf, qt);
-                slicedOp[g][m][t] = buf;
-            }
-        }
+
+        op[g] = trace(gamma*q_loop);
+        opPt.push_back(&op[g]);
+        ftPt.push_back(&op[g]);
     }
+    fft(opPt, ftPt, FFT::forward, fftPacked, fftPackedFt);
+    FftService::gatherMomenta(buf, ftPt, mom_);
     for (unsigned int g = 0; g < ngam; ++g)
     for (unsigned int m = 0; m < nmom; ++m)
     {
         for (unsigned int t = 0; t < nt; ++t)
         {
-            result[g][m].corr[t] = TensorRemove(trace(slicedOp[g][m][t]));
+            result[g][m].corr[t] = TensorRemove(buf[(g*nmom + m)*nt + t]);
         }
     }
     saveResult(par().output, "disc", result);
@@ -32,6 +32,7 @@
 #include <Hadrons/Global.hpp>
 #include <Hadrons/Module.hpp>
 #include <Hadrons/ModuleFactory.hpp>
+#include <Hadrons/MomentumProjector.hpp>
 
 BEGIN_HADRONS_NAMESPACE
 
@@ -146,11 +147,20 @@ std::vector<std::string> TGamma3pt<FImpl1, FImpl2, FImpl3>::getOutputFiles(void)
     return output;
 }
 
+// number of insertions contracted as fields at once, this bounds the number
+// of temporary fields
+constexpr unsigned int gamma3ptFieldChunk = 16;
+
 // setup ///////////////////////////////////////////////////////////////////////
 template <typename FImpl1, typename FImpl2, typename FImpl3>
 void TGamma3pt<FImpl1, FImpl2, FImpl3>::setup(void)
 {
-    envTmpLat(LatticeComplex, "c");
+    std::vector<Gamma::Algebra> gammaList;
+
+    parseGammaString(gammaList);
+    envTmp(std::vector<LatticeComplex>, "c", 1, 
+           std::min(gamma3ptFieldChunk, static_cast<unsigned int>(gammaList.size())),
+           envGetGrid(LatticeComplex));
 }
 
 template <typename FImpl1, typename FImpl2, typename FImpl3>
@@ -202,17 +212,29 @@ void TGamma3pt<FImpl1, FImpl2, FImpl3>::execute(void)
     }
     
     // Extract relevant timeslice of sinked propagator q1, then contract &
-    // sum over all spacial positions of gamma insertion.
-    SitePropagator1 q1Snk = q1[par().tSnk];
-    envGetTmp(LatticeComplex, c);
-    for (unsigned int i = 0; i < result.size(); ++i)
+    // sum over all spacial positions of gamma insertion, the insertions are
+    // reduced together by chunks of at most gamma3ptFieldChunk.
+    SitePropagator1   q1Snk = q1[par().tSnk];
+    MomentumProjector proj(env().getGrid(), {std::vector<Real>(env().getNd() - 1, 0.)}, Tp);
+    envGetTmp(std::vector<LatticeComplex>, c);
+    for (unsigned int i0 = 0; i0 < result.size(); i0 += c.size())
     {
-        Gamma gamma(gammaList[i]);
-        c = trace(g5*q1Snk*adj(q2)*(g5*gamma)*q3);
-        sliceSum(c, buf, Tp);
-        for (unsigned int t = 0; t < buf.size(); ++t)
+        const unsigned int                 n = std::min(static_cast<unsigned int>(c.size()),
+                                                        static_cast<unsigned int>(result.size()) - i0);
+        std::vector<const LatticeComplex *> cPt;
+
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            Gamma gamma(gammaList[i0 + i]);
+
+            c[i] = trace(g5*q1Snk*adj(q2)*(g5*gamma)*q3);
+            cPt.push_back(&c[i]);
+        }
+        proj.project(buf, cPt);
+        for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int t = 0; t < nt; ++t)
         {
-            result[i].corr[t] = TensorRemove(buf[t]);
+            result[i0 + i].corr[t] = TensorRemove(buf[i*nt + t]);
         }
     }
     saveResult(par().output, "gamma3pt", result);
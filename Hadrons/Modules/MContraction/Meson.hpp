@@ -34,6 +34,8 @@
 #include <Hadrons/Module.hpp>
 #include <Hadrons/ModuleFactory.hpp>
 #include <Hadrons/Modules/MSource/Point.hpp>
+#include <Hadrons/Modules/MSink/Point.hpp>
+#include <Hadrons/MomentumProjector.hpp>
 
 BEGIN_HADRONS_NAMESPACE
 
@@ -138,12 +140,232 @@ protected:
     virtual void execute(void);
 private:
     std::vector<Gamma::Algebra>        gammaList;
-    std::vector<RealD>               stag_phase_source;
+    std::vector<unsigned int>          stag_mask_sink;
+    std::vector<RealD>                 stag_phase_source;
 };
 
 MODULE_REGISTER_TMP(Meson, ARG(TMeson<FIMPL, FIMPL>), MContraction);
 MODULE_REGISTER_TMP(StagMeson, ARG(TStagMeson<STAGIMPL, STAGIMPL>), MContraction);
 
+/******************************************************************************
+ *                  Fused multi-gamma meson contraction                       *
+ ******************************************************************************/
+// The gamma structures A = g5*gSnk and B = adj(gSrc)*g5 of the connected meson
+// contraction tr[A q1 B adj(q2) sink] are signed permutations. For each pair
+// they are stored as the column and value of the non-zero element of each row.
+// The rank-4 spin tensor
+//   X(b, c, d, a) = tr_colour[q1(b, c) P(d, a)],  P = adj(q2)*sink,
+// is computed once per site and each correlator is then the 16-term sum
+//   sum_{a, c} A(a, b) B(c, d) X(b, c, d, a),
+// so the cost of going through the propagators does not depend on the number
+// of gamma pairs.
+struct MesonGammaSparse
+{
+    int     snkCol[Ns], srcCol[Ns];
+    Complex snkVal[Ns], srcVal[Ns];
+};
+
+inline std::vector<MesonGammaSparse> 
+makeMesonGammaTable(const std::vector<GammaPair> &gammaList)
+{
+    Gamma                         g5(Gamma::Algebra::Gamma5);
+    SpinMatrix                    id, a, b;
+    std::vector<MesonGammaSparse> table(gammaList.size());
+
+    id = Zero();
+    for (int s = 0; s < Ns; ++s)
+    {
+        id()(s, s)() = 1.;
+    }
+    for (unsigned int i = 0; i < gammaList.size(); ++i)
+    {
+        Gamma gSnk(gammaList[i].first);
+        Gamma gSrc(gammaList[i].second);
+
+        a = (g5*gSnk)*id;
+        b = id*(adj(gSrc)*g5);
+        for (int r = 0; r < Ns; ++r)
+        for (int s = 0; s < Ns; ++s)
+        {
+            if (a()(r, s)() != 0.)
+            {
+                table[i].snkCol[r] = s;
+                table[i].snkVal[r] = a()(r, s)();
+            }
+            if (b()(r, s)() != 0.)
+            {
+                table[i].srcCol[r] = s;
+                table[i].srcVal[r] = b()(r, s)();
+            }
+        }
+    }
+
+    return table;
+}
+
+// compute all the contractions for one site (SIMD or scalar) and pass them to
+// out(i, value), i being the index in the gamma table
+template <typename Site1, typename Site2, typename Out>
+inline void mesonContractSite(const Site1 &q1, const Site2 &p,
+                              const std::vector<MesonGammaSparse> &table,
+                              Out &&out)
+{
+    typedef typename std::decay<decltype(q1()(0, 0)(0, 0))>::type Scalar;
+
+    Scalar x[Ns][Ns][Ns][Ns];
+
+    for (int b = 0; b < Ns; ++b)
+    for (int c = 0; c < Ns; ++c)
+    for (int d = 0; d < Ns; ++d)
+    for (int a = 0; a < Ns; ++a)
+    {
+        Scalar &xs = x[b][c][d][a];
+
+        zeroit(xs);
+        for (int i = 0; i < Nc; ++i)
+        for (int j = 0; j < Nc; ++j)
+        {
+            xs += q1()(b, c)(i, j)*p()(d, a)(j, i);
+        }
+    }
+    for (unsigned int i = 0; i < table.size(); ++i)
+    {
+        const MesonGammaSparse &g = table[i];
+        Scalar                 r;
+
+        zeroit(r);
+        for (int a = 0; a < Ns; ++a)
+        for (int c = 0; c < Ns; ++c)
+        {
+            r += x[g.snkCol[a]][c][g.srcCol[c]][a]*(g.snkVal[a]*g.srcVal[c]);
+        }
+        out(i, r);
+    }
+}
+
+// reduce per outer time slice SIMD partial sums lvSum (layout i*rd + r, rd
+// being the reduced time extent) to res (layout i*nt + t) on all nodes
+inline void mesonSliceReduce(std::vector<ComplexD> &res, const vComplex *lvSum,
+                             const int nComp, GridBase *grid)
+{
+    typedef typename LatticeComplex::vector_object::scalar_type Scalar;
+
+    const int  nd{grid->_ndimension};
+    const int  tdir{nd - 1};
+    const int  Nsimd{grid->Nsimd()};
+    const int  fd{grid->_fdimensions[tdir]};
+    const int  ld{grid->_ldimensions[tdir]};
+    const int  rd{grid->_rdimensions[tdir]};
+    const int  tFirst{grid->_processor_coor[tdir]*ld};
+    Coordinate icoor(nd);
+
+    res.assign(nComp*fd, 0.);
+    for (int i = 0; i < nComp; i++)
+    for (int r = 0; r < rd; r++)
+    {
+        const Scalar *lane = reinterpret_cast<const Scalar *>(&lvSum[i*rd + r]);
+
+        for (int idx = 0; idx < Nsimd; idx++)
+        {
+            grid->iCoorFromIindex(icoor, idx);
+            res[i*fd + tFirst + r + icoor[tdir]*rd] += static_cast<ComplexD>(lane[idx]);
+        }
+    }
+    grid->GlobalSumVector(res.data(), res.size());
+}
+
+// all contractions with a propagator sink, summed over time slices in a single
+// pass: res (size table.size()*nt, layout i*nt + t) is globally summed. The
+// threads share all the outer sites and accumulate per-thread partial sums,
+// the outer time slice of site ss being (ss/ostride) % rd.
+template <typename Field1, typename Field2, typename SinkField>
+inline void mesonFusedSliceSum(std::vector<ComplexD> &res, const Field1 &q1,
+                               const Field2 &q2, const SinkField &sink,
+                               const std::vector<MesonGammaSparse> &table)
+{
+    GridBase                                      *grid = q1.Grid();
+    const int                                     tdir{grid->_ndimension - 1};
+    const int                                     rd{grid->_rdimensions[tdir]};
+    const int                                     ostride{grid->_ostride[tdir]};
+    const int                                     osites{grid->oSites()};
+    const int                                     nPair = table.size();
+    const int                                     nSum{nPair*rd};
+    const int                                     nthread{GridThread::GetThreads()};
+    std::vector<vComplex, alignedAllocator<vComplex>> lvSum(nthread*nSum);
+
+    {
+        autoView(q1_v, q1, CpuRead);
+        autoView(q2_v, q2, CpuRead);
+        autoView(sink_v, sink, CpuRead);
+        thread_for(thr, nthread,
+        {
+            int      mywork, myoff;
+            vComplex *sum = &lvSum[thr*nSum];
+
+            GridThread::GetWork(osites, thr, mywork, myoff);
+            for (int i = 0; i < nSum; ++i)
+            {
+                sum[i] = Zero();
+            }
+            for (int ss = myoff; ss < myoff + mywork; ss++)
+            {
+                const int  r{(ss/ostride) % rd};
+                const auto p = adj(q2_v[ss])*sink_v[ss];
+
+                mesonContractSite(q1_v[ss], p, table, 
+                                  [sum, rd, r](const int i, const vComplex &c)
+                {
+                    sum[i*rd + r] += c;
+                });
+            }
+        });
+    }
+    thread_for(i, nSum,
+    {
+        for (int thr = 1; thr < nthread; ++thr)
+        {
+            lvSum[i] += lvSum[thr*nSum + i];
+        }
+    });
+    mesonSliceReduce(res, lvSum.data(), nPair, grid);
+}
+
+// number of gamma pairs contracted as fields at once for a generic sink
+// function, this bounds the number of temporary fields
+constexpr unsigned int mesonFieldChunk = 16;
+
+// all contractions as fields (for a sink function), c[i] for table entry i
+template <typename Field1, typename Field2>
+inline void mesonFusedField(std::vector<LatticeComplex> &c, const Field1 &q1,
+                            const Field2 &q2,
+                            const std::vector<MesonGammaSparse> &table)
+{
+    typedef decltype(c[0].View(CpuWrite)) View;
+
+    std::vector<View> c_v;
+
+    for (unsigned int i = 0; i < table.size(); ++i)
+    {
+        c_v.push_back(c[i].View(CpuWrite));
+    }
+    {
+        autoView(q1_v, q1, CpuRead);
+        autoView(q2_v, q2, CpuRead);
+        thread_for(ss, q1.Grid()->oSites(),
+        {
+            mesonContractSite(q1_v[ss], adj(q2_v[ss]), table,
+                              [&c_v, ss](const int i, const vComplex &r)
+            {
+                c_v[i][ss]()()() = r;
+            });
+        });
+    }
+    for (auto &v: c_v)
+    {
+        v.ViewClose();
+    }
+}
+
 /******************************************************************************
  *                           TMeson implementation                            *
  ******************************************************************************/
@@ -207,12 +429,21 @@ std::vector<std::string> TMeson<FImpl1, FImpl2>::getOutputFiles(void)
 template <typename FImpl1, typename FImpl2>
 void TMeson<FImpl1, FImpl2>::setup(void)
 {
-    envTmpLat(LatticeComplex, "c");
-}
+    std::vector<GammaPair> gammaList;
+    std::string            ns;
 
-// execution ///////////////////////////////////////////////////////////////////
-#define mesonConnected(q1, q2, gSnk, gSrc) \
-(g5*(gSnk))*(q1)*(adj(gSrc)*g5)*adj(q2)
+    parseGammaString(gammaList);
+    ns = vm().getModuleNamespace(env().getObjectModule(par().sink));
+    // sinks exposing a momentum projector are projected on the fly and do not
+    // need fields
+    if ((ns == "MSink") and
+        !dynamic_cast<MomentumProjectorSink *>(vm().getModule(par().sink)))
+    {
+        envTmp(std::vector<LatticeComplex>, "c", 1,
+               std::min(mesonFieldChunk, static_cast<unsigned int>(gammaList.size())),
+               envGetGrid(LatticeComplex));
+    }
+}
 
 template <typename FImpl1, typename FImpl2>
 void TMeson<FImpl1, FImpl2>::execute(void)
@@ -221,11 +452,11 @@ void TMeson<FImpl1, FImpl2>::execute(void)
                  << " quarks '" << par().q1 << "' and '" << par().q2 << "'"
                  << std::endl;
 
-    std::vector<TComplex>  buf;
-    std::vector<Result>    result;
-    Gamma                  g5(Gamma::Algebra::Gamma5);
-    std::vector<GammaPair> gammaList;
-    int                    nt = env().getDim(Tp);
+    std::vector<TComplex>         buf;
+    std::vector<Result>           result;
+    std::vector<GammaPair>        gammaList;
+    std::vector<MesonGammaSparse> table;
+    int                           nt = env().getDim(Tp);
 
     parseGammaString(gammaList);
     result.resize(gammaList.size());
@@ -235,6 +466,7 @@ void TMeson<FImpl1, FImpl2>::execute(void)
         result[i].gamma_src = gammaList[i].second;
         result[i].corr.resize(nt);
     }
+    table = makeMesonGammaTable(gammaList);
     if (envHasType(SlicedPropagator1, par().q1) and
         envHasType(SlicedPropagator2, par().q2))
     {
@@ -242,52 +474,245 @@ void TMeson<FImpl1, FImpl2>::execute(void)
         auto &q2 = envGet(SlicedPropagator2, par().q2);
 
         LOG(Message) << "(propagator already sinked)" << std::endl;
-        for (unsigned int i = 0; i < result.size(); ++i)
+        for (unsigned int t = 0; t < nt; ++t)
         {
-            Gamma gSnk(gammaList[i].first);
-            Gamma gSrc(gammaList[i].second);
-
-            for (unsigned int t = 0; t < nt; ++t)
+            mesonContractSite(q1[t], adj(q2[t]), table,
+                              [&result, t](const int i, const Complex &c)
             {
-                result[i].corr[t] = TensorRemove(trace(mesonConnected(q1[t], q2[t], gSnk, gSrc)));
-            }
+                result[i].corr[t] = c;
+            });
         }
     }
     else
     {
-        auto &q1 = envGet(PropagatorField1, par().q1);
-        auto &q2 = envGet(PropagatorField2, par().q2);
-
-        envGetTmp(LatticeComplex, c);
-        LOG(Message) << "(using sink '" << par().sink << "')" << std::endl;
-        for (unsigned int i = 0; i < result.size(); ++i)
+        auto        &q1 = envGet(PropagatorField1, par().q1);
+        auto        &q2 = envGet(PropagatorField2, par().q2);
+        std::string ns;
+
+        LOG(Message) << "(using sink '" << par().sink << "', "
+                     << gammaList.size() << " gamma pairs in a single pass)"
+                     << std::endl;
+        ns = vm().getModuleNamespace(env().getObjectModule(par().sink));
+        if (ns == "MSource")
         {
-            Gamma       gSnk(gammaList[i].first);
-            Gamma       gSrc(gammaList[i].second);
-            std::string ns;
+            PropagatorField1      &sink = envGet(PropagatorField1, par().sink);
+            std::vector<ComplexD> corr;
 
-            ns = vm().getModuleNamespace(env().getObjectModule(par().sink));
-            if (ns == "MSource")
+            mesonFusedSliceSum(corr, q1, q2, sink, table);
+            for (unsigned int i = 0; i < result.size(); ++i)
+            for (unsigned int t = 0; t < nt; ++t)
             {
-                PropagatorField1 &sink = envGet(PropagatorField1, par().sink);
+                result[i].corr[t] = corr[i*nt + t];
+            }
+        }
+        else if (ns == "MSink")
+        {
+            SinkFnScalar &sink     = envGet(SinkFnScalar, par().sink);
+            auto         *projSink = dynamic_cast<MomentumProjectorSink *>(
+                                         vm().getModule(par().sink));
 
-                c = trace(mesonConnected(q1, q2, gSnk, gSrc)*sink);
-                sliceSum(c, buf, Tp);
+            if (projSink)
+            {
+                // momentum projection sink: all pairs are projected in a
+                // single reduction, directly from the propagators
+                typedef typename LatticeComplex::vector_object vobj;
+
+                const MomentumProjector &proj = projSink->getMomentumProjector();
+
+                {
+                    autoView(q1_v, q1, CpuRead);
+                    autoView(q2_v, q2, CpuRead);
+                    proj.projectSites<vobj>(buf, table.size(),
+                                            [&](const int ss, vobj *c)
+                    {
+                        mesonContractSite(q1_v[ss], adj(q2_v[ss]), table,
+                                          [c](const int i, const vComplex &r)
+                        {
+                            c[i]()()() = r;
+                        });
+                    });
+                }
+                for (unsigned int i = 0; i < result.size(); ++i)
+                for (unsigned int t = 0; t < nt; ++t)
+                {
+                    result[i].corr[t] = TensorRemove(buf[i*nt + t]);
+                }
             }
-            else if (ns == "MSink")
+            else
             {
-                SinkFnScalar &sink = envGet(SinkFnScalar, par().sink);
+                // generic sink: pairs are contracted as fields in chunks
+                envGetTmp(std::vector<LatticeComplex>, c);
+                for (unsigned int i0 = 0; i0 < table.size(); i0 += c.size())
+                {
+                    const unsigned int            n = std::min(static_cast<unsigned int>(c.size()),
+                                                               static_cast<unsigned int>(table.size() - i0));
+                    std::vector<MesonGammaSparse> chunk(table.begin() + i0,
+                                                        table.begin() + i0 + n);
+
+                    mesonFusedField(c, q1, q2, chunk);
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                        buf = sink(c[i]);
+                        for (unsigned int t = 0; t < buf.size(); ++t)
+                        {
+                            result[i0 + i].corr[t] = TensorRemove(buf[t]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    saveResult(par().output, "meson", result);
+}
 
-                c   = trace(mesonConnected(q1, q2, gSnk, gSrc));
-                buf = sink(c);
+/******************************************************************************
+ *                 Single-pass staggered taste contractions                   *
+ ******************************************************************************/
+// The local staggered bilinears only differ by a sign (-1)^(sum_mu x_mu) at
+// the sink, mu running over the directions set in a bit mask. The signs are
+// evaluated from the site coordinates: for each direction and parity of the
+// outer site coordinate, lanes[2*mu + p] holds the sign of every SIMD lane.
+inline void stagSignLanes(std::vector<vComplex, alignedAllocator<vComplex>> &lanes,
+                          GridBase *grid)
+{
+    typedef typename LatticeComplex::vector_object::scalar_type Scalar;
+
+    const int  nd{grid->_ndimension};
+    const int  Nsimd{grid->Nsimd()};
+    Coordinate icoor(nd);
+
+    lanes.resize(2*nd);
+    for (int mu = 0; mu < nd; ++mu)
+    for (int p = 0; p < 2; ++p)
+    {
+        Scalar *lane = reinterpret_cast<Scalar *>(&lanes[2*mu + p]);
+
+        for (int idx = 0; idx < Nsimd; idx++)
+        {
+            grid->iCoorFromIindex(icoor, idx);
+            lane[idx] = ((p + icoor[mu]*grid->_rdimensions[mu]) % 2) ? -1. : 1.;
+        }
+    }
+}
+
+inline vComplex stagSign(const std::vector<vComplex, alignedAllocator<vComplex>> &lanes,
+                         const Coordinate &x, const unsigned int mask)
+{
+    vComplex sign;
+
+    vone(sign);
+    for (int mu = 0; mu < x.size(); ++mu)
+    {
+        if (mask & (1u << mu))
+        {
+            sign = sign*lanes[2*mu + (x[mu] % 2)];
+        }
+    }
+
+    return sign;
+}
+
+// tr(q1 adj(q2)) with all the sink signs and source phases, summed over time
+// slices in a single pass: res (size mask.size()*nt, layout i*nt + t)
+template <typename Field1, typename Field2>
+inline void stagMesonSliceSum(std::vector<ComplexD> &res, const Field1 &q1,
+                              const Field2 &q2,
+                              const std::vector<unsigned int> &mask,
+                              const std::vector<RealD> &srcPhase)
+{
+    GridBase                                      *grid = q1.Grid();
+    const int                                     nd{grid->_ndimension};
+    const int                                     tdir{nd - 1};
+    const int                                     rd{grid->_rdimensions[tdir]};
+    const int                                     ostride{grid->_ostride[tdir]};
+    const int                                     osites{grid->oSites()};
+    const int                                     nGamma = mask.size();
+    const int                                     nSum{nGamma*rd};
+    const int                                     nthread{GridThread::GetThreads()};
+    Coordinate                                    start(nd);
+    std::vector<vComplex, alignedAllocator<vComplex>> lanes, ph(nGamma), lvSum(nthread*nSum);
+
+    for (int mu = 0; mu < nd; ++mu)
+    {
+        start[mu] = grid->_processor_coor[mu]*grid->_ldimensions[mu];
+    }
+    for (int i = 0; i < nGamma; ++i)
+    {
+        vsplat(ph[i], Complex(srcPhase[i]));
+    }
+    stagSignLanes(lanes, grid);
+    // same threading as mesonFusedSliceSum: per-thread partial sums over all
+    // the outer sites
+    {
+        autoView(q1_v, q1, CpuRead);
+        autoView(q2_v, q2, CpuRead);
+        thread_for(thr, nthread,
+        {
+            int        mywork, myoff;
+            vComplex   *sum = &lvSum[thr*nSum];
+            Coordinate x(nd);
+
+            GridThread::GetWork(osites, thr, mywork, myoff);
+            for (int i = 0; i < nSum; ++i)
+            {
+                sum[i] = Zero();
             }
-            for (unsigned int t = 0; t < buf.size(); ++t)
+            for (int ss = myoff; ss < myoff + mywork; ss++)
             {
-                result[i].corr[t] = TensorRemove(buf[t]);
+                const int      r{(ss/ostride) % rd};
+                const vComplex c = TensorRemove(trace(q1_v[ss]*adj(q2_v[ss])));
+
+                grid->oCoorFromOindex(x, ss);
+                for (int mu = 0; mu < nd; ++mu)
+                {
+                    x[mu] += start[mu];
+                }
+                for (int i = 0; i < nGamma; ++i)
+                {
+                    sum[i*rd + r] += stagSign(lanes, x, mask[i])*ph[i]*c;
+                }
             }
+        });
+    }
+    thread_for(i, nSum,
+    {
+        for (int thr = 1; thr < nthread; ++thr)
+        {
+            lvSum[i] += lvSum[thr*nSum + i];
         }
+    });
+    mesonSliceReduce(res, lvSum.data(), nGamma, grid);
+}
+
+// c = srcPhase*(-1)^(sum_{mu in mask} x_mu)*c0
+inline void stagMesonSign(LatticeComplex &c, const LatticeComplex &c0,
+                          const unsigned int mask, const RealD srcPhase)
+{
+    GridBase                                      *grid = c0.Grid();
+    const int                                     nd{grid->_ndimension};
+    Coordinate                                    start(nd);
+    std::vector<vComplex, alignedAllocator<vComplex>> lanes;
+    vComplex                                      ph;
+
+    for (int mu = 0; mu < nd; ++mu)
+    {
+        start[mu] = grid->_processor_coor[mu]*grid->_ldimensions[mu];
     }
-    saveResult(par().output, "meson", result);
+    vsplat(ph, Complex(srcPhase));
+    stagSignLanes(lanes, grid);
+    autoView(c_v, c, CpuWrite);
+    autoView(c0_v, c0, CpuRead);
+    thread_for(ss, grid->oSites(),
+    {
+        Coordinate x(nd);
+
+        grid->oCoorFromOindex(x, ss);
+        for (int mu = 0; mu < nd; ++mu)
+        {
+            x[mu] += start[mu];
+        }
+        c_v[ss]()()() = stagSign(lanes, x, mask)*ph*c0_v[ss]()()();
+    });
 }
 
 /******************************************************************************
@@ -344,49 +769,42 @@ template <typename FImpl1, typename FImpl2>
 void TStagMeson<FImpl1, FImpl2>::setup(void)
 {
     envTmpLat(LatticeComplex, "c");
+    envTmpLat(LatticeComplex, "c0");
     parseGammaString();
     int Ngam=gammaList.size();
 
-    // grid can't handle real * prop, so use complex
-    envTmp(std::vector<LatticeComplex>,  "stag_phase_sink", 1, Ngam,
-           LatticeComplex(env().getGrid()));
-    envGetTmp(std::vector<LatticeComplex>,stag_phase_sink);
+    // sink phases are coordinate parities, only the direction masks are kept
+    stag_mask_sink.assign(Ngam, 0);
     stag_phase_source.resize(Ngam);
 
-    Lattice<iScalar<vInteger> > x(env().getGrid()); LatticeCoordinate(x,0);
-    Lattice<iScalar<vInteger> > y(env().getGrid()); LatticeCoordinate(y,1);
-    Lattice<iScalar<vInteger> > z(env().getGrid()); LatticeCoordinate(z,2);
-    Lattice<iScalar<vInteger> > t(env().getGrid()); LatticeCoordinate(t,3);
-
     // coordinate of source
     std::vector<int> src_coor = strToVec<int>(static_cast<MSource::StagPoint *>(vm().getModule(par().source))->par().position);
     // local taste non-singlet ops, including ``Hermiticity" phase,
     // see Tab. 11.2 in Degrand and Detar
     for(int i=0; i < gammaList.size(); i++){
 
-        stag_phase_sink[i] = 1.0;
         stag_phase_source[i] = 1.0;
 
         LOG(Message) << "Using gamma: " << gammaList[i] << std::endl;
         switch(gammaList[i]) {
 
             case Gamma::Algebra::GammaX  :
-                stag_phase_sink[i] = where( mod(x,2)==(Integer)0, stag_phase_sink[i], -stag_phase_sink[i]);
+                stag_mask_sink[i] = 1u << 0;
                 if((src_coor[0])%2) stag_phase_source[i]= -stag_phase_source[i];
                 break;
 
             case Gamma::Algebra::GammaY  :
-                stag_phase_sink[i] = where( mod(y,2)==(Integer)0, stag_phase_sink[i], -stag_phase_sink[i]);
+                stag_mask_sink[i] = 1u << 1;
                 if((src_coor[1])%2) stag_phase_source[i]= -stag_phase_source[i];
                 break;
 
             case Gamma::Algebra::GammaZ  :
-                stag_phase_sink[i] = where( mod(z,2)==(Integer)0, stag_phase_sink[i], -stag_phase_sink[i]);
+                stag_mask_sink[i] = 1u << 2;
                 if((src_coor[2])%2) stag_phase_source[i] = -stag_phase_source[i];
                 break;
 
             case Gamma::Algebra::GammaT  :
-                stag_phase_sink[i] = where( mod(t,2)==(Integer)0, stag_phase_sink[i], -stag_phase_sink[i]);
+                stag_mask_sink[i] = 1u << 3;
                 if((src_coor[3])%2) stag_phase_source[i] = -stag_phase_source[i];
                 break;
 
@@ -401,9 +819,6 @@ void TStagMeson<FImpl1, FImpl2>::setup(void)
 }
 
 // execution ///////////////////////////////////////////////////////////////////
-#define StagMesonConnected(q1, q2, gSnk, gSrc) \
-(gSnk)*(q1)*adj(q2)*(gSrc)
-
 template <typename FImpl1, typename FImpl2>
 void TStagMeson<FImpl1, FImpl2>::execute(void)
 {
@@ -414,8 +829,6 @@ void TStagMeson<FImpl1, FImpl2>::execute(void)
     std::vector<TComplex>  buf;
     std::vector<Result>    result;
     int                    nt = env().getDim(Tp);
-    // staggered gammas
-    envGetTmp(std::vector<LatticeComplex>,stag_phase_sink);
 
     result.resize(gammaList.size());
     for (unsigned int i = 0; i < result.size(); ++i)
@@ -434,33 +847,37 @@ void TStagMeson<FImpl1, FImpl2>::execute(void)
     {
         auto &q1 = envGet(PropagatorField1, par().q1);
         auto &q2 = envGet(PropagatorField2, par().q2);
+        std::string ns;
 
-        envGetTmp(LatticeComplex, c);
-        //envGetTmp(LatticeComplex, phase);
-
-        //LOG(Message) << "(source position '" << location << "')" << std::endl;
-
-        LOG(Message) << "(using sink '" << par().sink << "')" << std::endl;
-        for (unsigned int i = 0; i < result.size(); ++i)
+        LOG(Message) << "(using sink '" << par().sink << "', "
+                     << gammaList.size() << " tastes in a single pass)" << std::endl;
+        ns = vm().getModuleNamespace(env().getObjectModule(par().sink));
+        if (ns == "MSource")
         {
-            std::string ns;
+            std::vector<ComplexD> corr;
 
-            ns = vm().getModuleNamespace(env().getObjectModule(par().sink));
-            if (ns == "MSource")
+            stagMesonSliceSum(corr, q1, q2, stag_mask_sink, stag_phase_source);
+            for (unsigned int i = 0; i < result.size(); ++i)
+            for (unsigned int t = 0; t < nt; ++t)
             {
-                PropagatorField1 &sink = envGet(PropagatorField1, par().sink);
-                c = trace(StagMesonConnected(q1, q2, stag_phase_sink[i], stag_phase_source[i]));
-                sliceSum(c, buf, Tp);
+                result[i].corr[t] = corr[i*nt + t];
             }
-            else if (ns == "MSink")
+        }
+        else if (ns == "MSink")
+        {
+            SinkFnScalar &sink = envGet(SinkFnScalar, par().sink);
+
+            envGetTmp(LatticeComplex, c);
+            envGetTmp(LatticeComplex, c0);
+            c0 = trace(q1*adj(q2));
+            for (unsigned int i = 0; i < result.size(); ++i)
             {
-                SinkFnScalar &sink = envGet(SinkFnScalar, par().sink);
-                c   = trace(StagMesonConnected(q1, q2, stag_phase_sink[i], stag_phase_source[i]));
+                stagMesonSign(c, c0, stag_mask_sink[i], stag_phase_source[i]);
                 buf = sink(c);
-            }
-            for (unsigned int t = 0; t < buf.size(); ++t)
-            {
-                result[i].corr[t] = TensorRemove(buf[t]);
+                for (unsigned int t = 0; t < buf.size(); ++t)
+                {
+                    result[i].corr[t] = TensorRemove(buf[t]);
+                }
             }
         }
     }
@@ -48,6 +48,7 @@ public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(StagA2AMesonFieldPar,
                                     int, cacheBlock,
                                     int, block,
+                                    bool, tune,
                                     std::string, left,
                                     std::string, right,
                                     std::string, output,
@@ -349,6 +350,11 @@ void TStagA2AMesonField<FImpl>::execute(void)
     Kernel      kernel(gamma_, ph, envGetGrid(FermionField));
 
     envGetTmp(Computation, computation);
+    if (par().tune)
+    {
+        computation.tune(vm().getModuleType(getName()), left, right, kernel,
+                         vm().getMemoryBudget(), vm().getDatabase());
+    }
     computation.execute(left, right, kernel, ionameFn, filenameFn, metadataFn);
 }
 
@@ -50,6 +50,7 @@ public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(StagA2AMesonFieldCCPar,
                                     int, cacheBlock,
                                     int, block,
+                                    unsigned int, transportCache,
                                     //int, Size,
                                     //int, istart,
                                     //int, jstart,
@@ -78,8 +79,8 @@ public:
 public:
     StagMesonFieldCCKernel(const std::vector<Gamma::Algebra> &gamma,
                            const std::vector<LatticeComplex> &mom,
-                           GridBase *grid)
-    : gamma_(gamma), mom_(mom), grid_(grid)
+                           GridBase *grid, const bool transported = false)
+    : gamma_(gamma), mom_(mom), grid_(grid), transported_(transported)
     {
         vol_ = 1.;
         for (auto &d: grid_->GlobalDimensions())
@@ -100,12 +101,12 @@ public:
     {
         A2Autils<FImpl>::StagMesonFieldCC(m, mu, Umu, left, right, gamma_, mom_, orthogDim, &t);
     }
+    // right vectors already multiplied by the link (see transportCache)
     void operator()(A2AMatrixSet<T> &m, const FermionField *left,
                     const FermionField *right,
                     const unsigned int orthogDim, double &t)
     {
-       //unimplemented
-        assert(0);
+        A2Autils<FImpl>::StagMesonField(m, left, right, orthogDim, &t);
     }
     void operator()(A2AMatrixSet<T> &m,
                     int mu,
@@ -123,6 +124,12 @@ public:
     }
     virtual double flops(const unsigned int blockSizei, const unsigned int blockSizej)
     {
+        // colour inner product only when the link multiplication is done
+        // outside of the kernel
+        if (transported_)
+        {
+            return vol_*(8.0*Nc)*blockSizei*blockSizej;
+        }
         // updated for staggered
         return vol_*(22.0+6.0*mom_.size())*blockSizei*blockSizej;
     }
@@ -139,6 +146,7 @@ private:
     const std::vector<LatticeComplex> &mom_;
     GridBase                          *grid_;
     double                            vol_;
+    bool                              transported_;
 };
 
 template <typename FImpl>
@@ -249,9 +257,34 @@ void TStagA2AMesonFieldCC<FImpl>::setup(void)
     //printMem("StagMesonFieldCC setup(): after envCache ", env().getGrid()->ThisRank());
     envTmpLat(ComplexField, "coor");
     //printMem("StagMesonFieldCC setup(): after envTmpLat ", env().getGrid()->ThisRank());
-    envTmp(Computation, "computation", 1, envGetGrid(FermionField),
-           env().getNd() - 1, mom_.size(), gamma_.size(), par().block,
-           par().cacheBlock, this);
+    if (par().transportCache > 0)
+    {
+        // the link-multiplied right vectors of a block are cached, so the
+        // block size is bounded by the number of cached vectors
+        unsigned int block      = std::min(static_cast<unsigned int>(par().block),
+                                           par().transportCache);
+        unsigned int cacheBlock = std::min(static_cast<unsigned int>(par().cacheBlock),
+                                           block);
+
+        if (mom_.size() != 1)
+        {
+            HADRONS_ERROR(Size, "link-multiplied vector cache only supports one momentum");
+        }
+        envTmp(std::vector<FermionField>, "leftBuf", 1, block,
+               envGetGrid(FermionField));
+        envTmp(std::vector<FermionField>, "rightBuf", 1, block,
+               envGetGrid(FermionField));
+        envTmpLat(FermionField, "modeBuf");
+        envTmp(Computation, "computation", 1, envGetGrid(FermionField),
+               env().getNd() - 1, mom_.size(), gamma_.size(), block,
+               cacheBlock, this);
+    }
+    else
+    {
+        envTmp(Computation, "computation", 1, envGetGrid(FermionField),
+               env().getNd() - 1, mom_.size(), gamma_.size(), par().block,
+               par().cacheBlock, this);
+    }
     //printMem("StagMesonFieldCC setup() End ", env().getGrid()->ThisRank());
 }
 
@@ -354,11 +387,62 @@ void TStagA2AMesonFieldCC<FImpl>::execute(void)
     Umu = PeekIndex<LorentzIndex>(U,mu);
     Umu *= phases;
 
-    Kernel      kernel(gamma_, ph, envGetGrid(FermionField));
-
     envGetTmp(Computation, computation);
-    computation.execute(mu, Umu, epack.evec, epack.evec, kernel,
-                        ionameFn, filenameFn, metadataFn);
+    if (par().transportCache > 0)
+    {
+        // mode 2k is the eigenvector k, mode 2k+1 its partner with opposite
+        // eigenvalue, obtained with the parity sign ph[0]. The right modes
+        // are multiplied by the link, Umu(x) right(x + mu), once per right
+        // block and the contraction is a plain inner product (checked
+        // against the conserved current kernel in Test_stag_a2a_transport)
+        Kernel kernel(gamma_, ph, envGetGrid(FermionField), true);
+
+        envGetTmp(std::vector<FermionField>, leftBuf);
+        envGetTmp(std::vector<FermionField>, rightBuf);
+        envGetTmp(FermionField, modeBuf);
+
+        auto mode = [&epack, &ph](FermionField &out, const unsigned int i)
+        {
+            if (i % 2)
+            {
+                out = ph[0]*epack.evec[i/2];
+            }
+            else
+            {
+                out = epack.evec[i/2];
+            }
+        };
+        auto leftFn = [&mode](std::vector<FermionField> &buf,
+                              const unsigned int i, const unsigned int n)
+        {
+            for (unsigned int k = 0; k < n; ++k)
+            {
+                mode(buf[k], i + k);
+            }
+        };
+        auto rightFn = [&mode, &modeBuf, &Umu, mu](std::vector<FermionField> &buf,
+                                                   const unsigned int j,
+                                                   const unsigned int n)
+        {
+            for (unsigned int k = 0; k < n; ++k)
+            {
+                mode(modeBuf, j + k);
+                buf[k] = Umu*Cshift(modeBuf, mu, 1);
+            }
+        };
+
+        LOG(Message) << "Caching up to " << rightBuf.size() 
+                     << " link-multiplied right vectors" << std::endl;
+        computation.execute(2*N_i, 2*N_j, leftBuf, rightBuf, leftFn, rightFn,
+                            kernel, ionameFn, filenameFn, metadataFn);
+    }
+    else
+    {
+        Kernel kernel(gamma_, ph, envGetGrid(FermionField));
+
+        computation.execute(mu, Umu, epack.evec, epack.evec, kernel,
+                            ionameFn, filenameFn, metadataFn);
+    }
 }
 
 END_MODULE_NAMESPACE
@@ -48,6 +48,7 @@ public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(StagSparseA2AMesonFieldPar,
                                     int, cacheBlock,
                                     int, block,
+                                    bool, tune,
                                     int, mu,
                                     std::string, left,
                                     std::string, right,
@@ -241,9 +242,16 @@ void TStagSparseA2AMesonField<FImpl>::execute(void)
         return md;
     };
 
-    Kernel      kernel(envGetGrid(FermionField));
+    // the vectors live on the sparse grid, so that the kernel cost (and its
+    // flop count) scales with the sparse volume
+    Kernel      kernel(left[0].Grid());
 
     envGetTmp(Computation, computation);
+    if (par().tune)
+    {
+        computation.tune(vm().getModuleType(getName()), left, right, kernel,
+                         vm().getMemoryBudget(), vm().getDatabase());
+    }
     computation.execute(left, right, kernel, ionameFn, filenameFn, metadataFn);
 }
 
@@ -33,6 +33,7 @@
 #include <Hadrons/Global.hpp>
 #include <Hadrons/Module.hpp>
 #include <Hadrons/ModuleFactory.hpp>
+#include <Hadrons/MomentumProjector.hpp>
 
 BEGIN_HADRONS_NAMESPACE
 
@@ -98,14 +99,14 @@ protected:
     virtual void setup(void);
     // execution
     virtual void execute(void);
-    // Perform Slice Sum and then save delta
-    void SliceOut(std::vector<Complex> &Out, SlicedComplex &Sum, const ComplexField &f, bool bDiff) const
+    // Save component i of a batched slice sum, or its delta
+    void SliceOut(std::vector<Complex> &Out, const SlicedComplex &Sum, const unsigned int i, bool bDiff) const
     {
-        sliceSum(f, Sum, Tp);
-        const auto nt = Sum.size();
+        const auto nt = Out.size();
+        const SlicedComplex::value_type *S = Sum.data() + i*nt;
         for (size_t t = 0; t < nt; ++t)
         {
-            Out[t] = TensorRemove(bDiff ? Sum[t] - Sum[(t-1+nt)%nt] : Sum[t]);
+            Out[t] = TensorRemove(bDiff ? S[t] - S[(t-1+nt)%nt] : S[t]);
         }
     }
 private:
@@ -154,7 +155,7 @@ void TWardIdentity<FImpl>::setup(void)
     }
     // These temporaries are always 4d
     envTmpLat(PropagatorField, "tmp");
-    envTmpLat(ComplexField, "tmp_current");
+    envTmp(std::vector<ComplexField>, "current", 1, 2, envGetGrid(ComplexField));
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -182,25 +183,27 @@ void TWardIdentity<FImpl>::execute(void)
     // Compute D_mu V_mu (D here is backward derivative)
     // There is no point performing Dmu on spatial directions, because after the spatial sum, these become zero
     envGetTmp(PropagatorField, tmp);
-    envGetTmp(ComplexField, tmp_current);
-    SlicedComplex sumSV(nt);
-    SlicedComplex sumVV(nt);
+    envGetTmp(std::vector<ComplexField>, current);
+    // current densities are reduced in pairs, with a single global sum
+    MomentumProjector proj(env().getGrid(), {std::vector<Real>(env().getNd() - 1, 0.)}, Tp);
+    SlicedComplex sum;
     LOG(Message) << "Getting vector conserved current" << std::endl;
     act.ContractConservedCurrent(prop, prop, tmp, phys_source, Current::Vector, Tdir);
     // Scalar-vector current density
-    tmp_current = trace(tmp);
-    SliceOut(result.DmuJmu, sumSV, tmp_current, true);
+    current[0] = trace(tmp);
     // Vector-vector current density
-    tmp_current = trace(gT*tmp);
-    SliceOut(result.VDmuJmu, sumVV, tmp_current, true);
+    current[1] = trace(gT*tmp);
+    proj.project(sum, current);
+    SliceOut(result.DmuJmu, sum, 0, true);
+    SliceOut(result.VDmuJmu, sum, 1, true);
 //#define COMPARE_Test_Cayley_mres
 #ifdef  COMPARE_Test_Cayley_mres
     // For comparison with Grid Test_Cayley_mres
     LOG(Message) << "Vector Ward Identity by timeslice" << std::endl;
     for (int t = 0; t < nt; ++t)
     {
-        LOG(Message) << " t=" << t << ", SV=" << real(TensorRemove(sumSV[t]))
-                     << ", VV=" << real(TensorRemove(sumVV[t])) << std::endl;
+        LOG(Message) << " t=" << t << ", SV=" << real(TensorRemove(sum[t]))
+                     << ", VV=" << real(TensorRemove(sum[nt + t])) << std::endl;
     }
 #endif
 
@@ -210,15 +213,14 @@ void TWardIdentity<FImpl>::execute(void)
         LOG(Message) << "Getting axial conserved current" << std::endl;
         act.ContractConservedCurrent(prop, prop, tmp, phys_source, Current::Axial, Tdir);
         // Pseudoscalar-Axial current density
-        tmp_current = trace(g5 * tmp);
-        SlicedComplex sumPA(nt);
+        current[0] = trace(g5 * tmp);
+        // <P|J5q>
+        act.ContractJ5q(prop, current[1]);
+        proj.project(sum, current);
         // Save temporal component of pseudoscalar-(partially) conserved axial
         // \mathcal{A}_0 from eq (37) in https://arxiv.org/pdf/hep-lat/0612005.pdf
-        SliceOut(result.PA0, sumPA, tmp_current, false);
-        // <P|J5q>
-        act.ContractJ5q(prop, tmp_current);
-        SlicedComplex sumPJ5q(nt);
-        SliceOut(result.PJ5q, sumPJ5q, tmp_current, false);
+        SliceOut(result.PA0, sum, 0, false);
+        SliceOut(result.PJ5q, sum, 1, false);
     }
 
     LOG(Message) << "Writing results to " << par().output << "." << std::endl;
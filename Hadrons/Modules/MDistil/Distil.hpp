@@ -41,6 +41,7 @@
 #include <Hadrons/Solver.hpp>
 #include <Hadrons/A2AVectors.hpp>
 #include <Hadrons/DilutedNoise.hpp>
+#include <Hadrons/DistilVectorSet.hpp>
 
 BEGIN_HADRONS_NAMESPACE
 BEGIN_MODULE_NAMESPACE(MDistil)
@@ -69,28 +70,6 @@ BEGIN_MODULE_NAMESPACE(MDistil)
 
 GRID_SERIALIZABLE_ENUM(pMode, undef, perambOnly, 0, inputSolve, 1, outputSolve, 2);
 
-#define DIST_SOURCE \
-for (int it = dt; it < Nt; it += dp.TI) \
-{ \
-    const int t_inv{(dp.tsrc + it)%Nt}; \
-    if( t_inv >= Ntfirst && t_inv < Ntfirst + Ntlocal ) \
-    { \
-        for (int ik = dk; ik < dp.nvec; ik += dp.LI) \
-        { \
-            for (int is = ds; is < Ns; is += dp.SI) \
-            { \
-                ExtractSliceLocal(evec3d,epack.evec[ik],0,t_inv-Ntfirst,Tdir); \
-                cv3dtmp = evec3d * noise.tensor(inoise, t_inv, ik, is); \
-                fermion3dtmp=0; \
-                pokeSpin(fermion3dtmp,cv3dtmp,is); \
-                fermion4dtmp=0; \
-                InsertSliceLocal(fermion3dtmp,fermion4dtmp,0,t_inv-Ntfirst,Tdir); \
-                dist_source += fermion4dtmp; \
-            } \
-        } \
-    } \
-}
-
 struct DistilParameters: Serializable {
     GRID_SERIALIZABLE_CLASS_MEMBERS(DistilParameters,
                                     int, nvec,
@@ -102,6 +81,36 @@ struct DistilParameters: Serializable {
                                     int, SI )
 };
 
+/******************************************************************************
+ Coefficients of the distillation source for noise inoise and dilution
+ component (dk, dt, ds) on the Laplacian eigenvectors: coef (size Nt*nvec,
+ layout t*nvec + k) is filled for all time slices, so that the source is
+ built with localSliceLinearCombination
+ ******************************************************************************/
+
+inline void DistilSourceCoef(SpinVector *coef, const NoiseTensor &noise,
+                             const DistilParameters &dp, const int Nt,
+                             const int inoise, const int dk, const int dt,
+                             const int ds)
+{
+    for (int i = 0; i < Nt*dp.nvec; i++)
+    {
+        coef[i] = Zero();
+    }
+    for (int it = dt; it < Nt; it += dp.TI)
+    {
+        const int t_inv{(dp.tsrc + it)%Nt};
+
+        for (int ik = dk; ik < dp.nvec; ik += dp.LI)
+        {
+            for (int is = ds; is < Ns; is += dp.SI)
+            {
+                coef[t_inv*dp.nvec + ik]()(is)() = noise.tensor(inoise, t_inv, ik, is);
+            }
+        }
+    }
+}
+
 /******************************************************************************
  Make a lower dimensional grid in preparation for local slice operations
  ******************************************************************************/
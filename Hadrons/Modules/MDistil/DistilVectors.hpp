@@ -37,6 +37,7 @@
 #define Hadrons_MDistil_DistilVectors_hpp_
 
 #include <Hadrons/Modules/MDistil/Distil.hpp>
+#include <Hadrons/DistilVectorSet.hpp>
 
 BEGIN_HADRONS_NAMESPACE
 BEGIN_MODULE_NAMESPACE(MDistil)
@@ -55,7 +56,8 @@ public:
                                     std::string, lapevec,
                                     std::string, rho,
                                     std::string, phi,
-                                    std::string, DistilParams);
+                                    std::string, DistilParams,
+                                    bool, compact);
 };
 
 template <typename FImpl>
@@ -69,13 +71,14 @@ public:
     virtual ~TDistilVectors(void) {};
     // dependency relation
     virtual std::vector<std::string> getInput(void);
+    virtual std::vector<std::string> getReference(void);
     virtual std::vector<std::string> getOutput(void);
     // setup
     virtual void setup(void);
     // execution
     virtual void execute(void);
-protected:
-    std::unique_ptr<GridCartesian> grid3d; // Owned by me, so I must delete it
+private:
+    void executeCompact(void);
 public:
     // These variables contain parameters
     std::string RhoName;
@@ -98,6 +101,18 @@ std::vector<std::string> TDistilVectors<FImpl>::getInput(void)
     return {par().noise,par().perambulator,par().lapevec,par().DistilParams};
 }
 
+template <typename FImpl>
+std::vector<std::string> TDistilVectors<FImpl>::getReference(void)
+{
+    // compact vectors are expanded from the Laplacian eigenvectors on demand
+    if (par().compact)
+    {
+        return {par().lapevec};
+    }
+
+    return {};
+}
+
 template <typename FImpl>
 std::vector<std::string> TDistilVectors<FImpl>::getOutput(void)
 {
@@ -129,64 +144,57 @@ void TDistilVectors<FImpl>::setup(void)
     const DistilParameters &dp{envGet(DistilParameters, par().DistilParams)};
     const int Nt{env().getDim(Tdir)};
     
+    if (par().compact)
+    {
+        auto &epack = envGet(Grid::Hadrons::EigenPack<ColourVectorField>, par().lapevec);
+        const int nVec{dp.nnoise*dp.LI*dp.SI*dp.inversions};
+
+        if (!RhoName.empty())
+            envCreate(DistilVectorSet<FImpl>, RhoName, 1, epack, nVec, dp.nvec, env().getGrid());
+        if (!PhiName.empty())
+            envCreate(DistilVectorSet<FImpl>, PhiName, 1, epack, nVec, dp.nvec, env().getGrid());
+        return;
+    }
     if (!RhoName.empty())
         envCreate(std::vector<FermionField>, RhoName, 1, dp.nnoise*dp.LI*dp.SI*dp.inversions, envGetGrid(FermionField));
     if (!PhiName.empty())
         envCreate(std::vector<FermionField>, PhiName, 1, dp.nnoise*dp.LI*dp.SI*dp.inversions, envGetGrid(FermionField));
-    
-    Coordinate latt_size   = GridDefaultLatt();
-    Coordinate mpi_layout  = GridDefaultMpi();
-    Coordinate simd_layout_3 = GridDefaultSimd(Nd-1, vComplex::Nsimd());
-    latt_size[Nd-1] = 1;
-    simd_layout_3.push_back( 1 );
-    mpi_layout[Nd-1] = 1;
-    GridCartesian * const grid4d{env().getGrid()};
-    MakeLowerDimGrid(grid3d, grid4d);
-    
-    envTmpLat(FermionField,     "dist_source");
-    envTmpLat(FermionField,     "fermion4dtmp");
-    envTmp(FermionField,        "fermion3dtmp", 1, grid3d.get());
-    envTmp(ColourVectorField,   "cv3dtmp", 1, grid3d.get());
-    envTmp(ColourVectorField,   "evec3d", 1, grid3d.get());
 }
 
 // execution ///////////////////////////////////////////////////////////////////
 template <typename FImpl>
 void TDistilVectors<FImpl>::execute(void)
 {
+    if (par().compact)
+    {
+        executeCompact();
+        return;
+    }
+
     auto &noise        = envGet(NoiseTensor,  par().noise);
     auto &perambulator = envGet(PerambTensor, par().perambulator);
     auto &epack        = envGet(Grid::Hadrons::EigenPack<ColourVectorField>, par().lapevec);
     const DistilParameters &dp{envGet(DistilParameters, par().DistilParams)};
-    
-    envGetTmp(FermionField,          dist_source);
-    envGetTmp(FermionField,          fermion4dtmp);
-    envGetTmp(FermionField,          fermion3dtmp);
-    envGetTmp(ColourVectorField,     cv3dtmp);
-    envGetTmp(ColourVectorField,     evec3d);
-    
-    GridCartesian * const grid4d{env().getGrid()};
-    const int Ntlocal{ grid4d->LocalDimensions()[3] };
-    const int Ntfirst{ grid4d->LocalStarts()[3] };
-    
     const int Nt{env().getDim(Tdir)}; 
     
+    // all vectors are built time-slice by time-slice from their coefficients
+    // on the Laplacian eigenvectors
+    std::vector<SpinVector> coef(Nt*dp.nvec);
     int vecindex;
     if (!RhoName.empty())
     {
         auto &rho = envGet(std::vector<FermionField>, RhoName);
         for (int inoise = 0; inoise < dp.nnoise; inoise++) 
-	{
+        {
             for (int dk = 0; dk < dp.LI; dk++) 
-	    {
+            {
                 for (int dt = 0; dt < dp.inversions; dt++) 
-		{
+                {
                     for (int ds = 0; ds < dp.SI; ds++) 
-		    {
+                    {
                         vecindex = inoise + dp.nnoise * (dk + dp.LI * (ds + dp.SI * dt));
-                        dist_source = 0;
-			DIST_SOURCE
-			rho[vecindex]=dist_source;
+                        DistilSourceCoef(coef.data(), noise, dp, Nt, inoise, dk, dt, ds);
+                        localSliceLinearCombination(rho[vecindex], epack.evec, dp.nvec, coef.data());
                     }
                 }
             }
@@ -196,25 +204,20 @@ void TDistilVectors<FImpl>::execute(void)
     {
         auto &phi = envGet(std::vector<FermionField>, PhiName);
         for (int inoise = 0; inoise < dp.nnoise; inoise++) 
-	{
+        {
             for (int dk = 0; dk < dp.LI; dk++) 
-	    {
+            {
                 for (int dt = 0; dt < dp.inversions; dt++) 
-		{
+                {
                     for (int ds = 0; ds < dp.SI; ds++) 
-		    {
+                    {
                         vecindex = inoise + dp.nnoise * (dk + dp.LI * (ds + dp.SI * dt));
-                        phi[vecindex] = 0;
-                        for (int t = Ntfirst; t < Ntfirst + Ntlocal; t++) 
-			{
-                            fermion3dtmp=0;
-                            for (int ivec = 0; ivec < dp.nvec; ivec++) 
-			    {
-                                ExtractSliceLocal(evec3d,epack.evec[ivec],0,t-Ntfirst,Tdir);
-                                fermion3dtmp += evec3d * perambulator.tensor(t, ivec, dk, inoise,dt,ds);
-                            }
-                            InsertSliceLocal(fermion3dtmp,phi[vecindex],0,t-Ntfirst,Tdir);
+                        for (int t = 0; t < Nt; t++) 
+                        for (int ivec = 0; ivec < dp.nvec; ivec++) 
+                        {
+                            coef[t*dp.nvec + ivec] = perambulator.tensor(t, ivec, dk, inoise, dt, ds);
                         }
+                        localSliceLinearCombination(phi[vecindex], epack.evec, dp.nvec, coef.data());
                     }
                 }
             }
@@ -222,6 +225,57 @@ void TDistilVectors<FImpl>::execute(void)
     }
 }
 
+// compact representation: only store the coefficients of the distillation
+// vectors in the Laplacian eigenvector basis on each time slice
+template <typename FImpl>
+void TDistilVectors<FImpl>::executeCompact(void)
+{
+    auto &noise        = envGet(NoiseTensor,  par().noise);
+    auto &perambulator = envGet(PerambTensor, par().perambulator);
+    const DistilParameters &dp{envGet(DistilParameters, par().DistilParams)};
+    const int Nt{env().getDim(Tdir)};
+
+    int vecindex;
+    if (!RhoName.empty())
+    {
+        auto &rho = envGet(DistilVectorSet<FImpl>, RhoName);
+
+        rho.zero();
+        for (int inoise = 0; inoise < dp.nnoise; inoise++)
+        for (int dk = 0; dk < dp.LI; dk++)
+        for (int dt = 0; dt < dp.inversions; dt++)
+        for (int ds = 0; ds < dp.SI; ds++)
+        {
+            vecindex = inoise + dp.nnoise * (dk + dp.LI * (ds + dp.SI * dt));
+            DistilSourceCoef(&rho.coef(vecindex, 0, 0), noise, dp, Nt, inoise, dk, dt, ds);
+        }
+        LOG(Message) << "rho: " << rho.size() << " compact vectors ("
+                     << sizeString(rho.size()*Nt*dp.nvec*sizeof(SpinVector))
+                     << ")" << std::endl;
+    }
+    if (!PhiName.empty())
+    {
+        auto &phi = envGet(DistilVectorSet<FImpl>, PhiName);
+
+        phi.zero();
+        for (int inoise = 0; inoise < dp.nnoise; inoise++)
+        for (int dk = 0; dk < dp.LI; dk++)
+        for (int dt = 0; dt < dp.inversions; dt++)
+        for (int ds = 0; ds < dp.SI; ds++)
+        {
+            vecindex = inoise + dp.nnoise * (dk + dp.LI * (ds + dp.SI * dt));
+            for (int t = 0; t < Nt; t++)
+            for (int ivec = 0; ivec < dp.nvec; ivec++)
+            {
+                phi.coef(vecindex, t, ivec) = perambulator.tensor(t, ivec, dk, inoise, dt, ds);
+            }
+        }
+        LOG(Message) << "phi: " << phi.size() << " compact vectors ("
+                     << sizeString(phi.size()*Nt*dp.nvec*sizeof(SpinVector))
+                     << ")" << std::endl;
+    }
+}
+
 END_MODULE_NAMESPACE
 END_HADRONS_NAMESPACE
 #endif // Hadrons_MDistil_DistilVectors_hpp_
@@ -92,7 +92,8 @@ struct LapEvecPar: Serializable {
                                     ,StoutParameters,     Stout
                                     ,ChebyshevParameters, Cheby
                                     ,LanczosParameters,   Lanczos
-                                    ,std::string,         FileName)
+                                    ,std::string,         FileName
+                                    ,bool,                SliceParallel)
 };
 
 /******************************************************************************
@@ -117,8 +118,13 @@ public:
     virtual void setup(void);
     // execution
     virtual void execute(void);
+private:
+    void executeSliceParallel(LapEvecs &eig4d, GaugeField &Umu_smear,
+                              TimesliceEvals &Evals, uint32_t &ConvergenceErrors);
 protected:
     std::unique_ptr<GridCartesian> gridLD; // Owned by me, so I must delete it
+    std::unique_ptr<GridCartesian> gridSplit; // One time slice per rank in SliceParallel mode
+    int                            splitRank{0};
 };
 
 MODULE_REGISTER_TMP(LapEvec, TLapEvec<GIMPL>, MDistil);
@@ -154,9 +160,25 @@ void TLapEvec<GImpl>::setup(void)
     // Temporaries
     envTmpLat(GaugeField, "Umu_stout");
     envTmpLat(GaugeField, "Umu_smear");
-    envTmp(LatticeGaugeField, "UmuNoTime", 1, gridLD.get());
-    envTmp(LatticeColourVector,     "src", 1, gridLD.get());
-    envTmp(std::vector<LapEvecs>,  "eig", 1, Ntlocal);
+    if( par().SliceParallel )
+    {
+        // Split the 3d grid so that every rank solves a whole time slice on its own
+        Coordinate mpi_split(gridLD->_ndimension, 1);
+        gridSplit.reset( new GridCartesian(gridLD->_gdimensions,gridLD->_simd_layout,
+                                           mpi_split,*gridLD,splitRank) );
+        const int nSplit{gridLD->_Nprocessors / gridSplit->_Nprocessors};
+        envTmp(std::vector<LatticeGaugeField>,   "UmuBatch",  1, nSplit, gridLD.get());
+        envTmp(std::vector<LatticeColourVector>, "evecBatch", 1, nSplit, gridLD.get());
+        envTmp(LatticeGaugeField,               "UmuSplit",  1, gridSplit.get());
+        envTmp(LatticeColourVector,             "srcSplit",  1, gridSplit.get());
+        envTmp(LapEvecs,                        "eigSplit",  1, par().Lanczos.Nk+par().Lanczos.Np, gridSplit.get());
+    }
+    else
+    {
+        envTmp(LatticeGaugeField, "UmuNoTime", 1, gridLD.get());
+        envTmp(LatticeColourVector,     "src", 1, gridLD.get());
+        envTmp(std::vector<LapEvecs>,  "eig", 1, Ntlocal);
+    }
     // Output objects
     envCreate(LapEvecs, getName(), 1, par().Lanczos.Nvec, gridHD);
 }
@@ -263,9 +285,6 @@ void TLapEvec<GImpl>::execute(void)
     ////////////////////////////////////////////////////////////////////////
     
     auto & eig4d = envGet(LapEvecs, getName() );
-    envGetTmp(std::vector<LapEvecs>, eig);   // Eigenpack for each timeslice
-    envGetTmp(LatticeGaugeField, UmuNoTime); // Gauge field without time dimension
-    envGetTmp(LatticeColourVector, src);
     GridCartesian * gridHD = env().getGrid();
     const int Ntlocal{gridHD->LocalDimensions()[Tdir]};
     const int Ntfirst{gridHD->LocalStarts()[Tdir]};
@@ -275,47 +294,55 @@ void TLapEvec<GImpl>::execute(void)
     for (int t = 0; t < NtFull; t++)
         for (int v = 0; v < LPar.Nvec; v++)
             Evals.tensor( t, v ) = 0;
-    for (int t = 0; t < Ntlocal; t++ )
+    if( par().SliceParallel )
+        executeSliceParallel(eig4d, Umu_smear, Evals, ConvergenceErrors);
+    else
     {
-        LOG(Message) << "------------------------------------------------------------" << std::endl;
-        LOG(Message) << " Compute eigenpack, local timeslice = " << t << " / " << Ntlocal << std::endl;
-        LOG(Message) << "------------------------------------------------------------" << std::endl;
-        eig[t].resize(LPar.Nk+LPar.Np,gridLD.get());
+        envGetTmp(std::vector<LapEvecs>, eig);   // Eigenpack for each timeslice
+        envGetTmp(LatticeGaugeField, UmuNoTime); // Gauge field without time dimension
+        envGetTmp(LatticeColourVector, src);
+        for (int t = 0; t < Ntlocal; t++ )
+        {
+            LOG(Message) << "------------------------------------------------------------" << std::endl;
+            LOG(Message) << " Compute eigenpack, local timeslice = " << t << " / " << Ntlocal << std::endl;
+            LOG(Message) << "------------------------------------------------------------" << std::endl;
+            eig[t].resize(LPar.Nk+LPar.Np,gridLD.get());
         
-        // Construct smearing operator
-        ExtractSliceLocal(UmuNoTime,Umu_smear,0,t,Tdir); // switch to 3d/4d objects
-        Laplacian3D<LatticeColourVector> Nabla(UmuNoTime);
-        LOG(Message) << "Chebyshev preconditioning to order " << ChebPar.PolyOrder
-                     << " with parameters (alpha,beta) = (" << ChebPar.alpha << "," << ChebPar.beta << ")" << std::endl;
-        Chebyshev<LatticeColourVector> Cheb(ChebPar.alpha,ChebPar.beta,ChebPar.PolyOrder);
+            // Construct smearing operator
+            ExtractSliceLocal(UmuNoTime,Umu_smear,0,t,Tdir); // switch to 3d/4d objects
+            Laplacian3D<LatticeColourVector> Nabla(UmuNoTime);
+            LOG(Message) << "Chebyshev preconditioning to order " << ChebPar.PolyOrder
+                         << " with parameters (alpha,beta) = (" << ChebPar.alpha << "," << ChebPar.beta << ")" << std::endl;
+            Chebyshev<LatticeColourVector> Cheb(ChebPar.alpha,ChebPar.beta,ChebPar.PolyOrder);
         
-        // Construct source vector according to Test_dwf_compressed_lanczos.cc
-        src = 11.0; // NB: This is a dummy parameter and just needs to be non-zero
-        RealD nn = norm2(src);
-        nn = Grid::sqrt(nn);
-        src = src * (1.0/nn);
+            // Construct source vector according to Test_dwf_compressed_lanczos.cc
+            src = 11.0; // NB: This is a dummy parameter and just needs to be non-zero
+            RealD nn = norm2(src);
+            nn = Grid::sqrt(nn);
+            src = src * (1.0/nn);
         
-        Laplacian3DHerm<LatticeColourVector> NablaCheby(Cheb,Nabla);
-        ImplicitlyRestartedLanczos<LatticeColourVector>
-        IRL(NablaCheby,Nabla,LPar.Nvec,LPar.Nk,LPar.Nk+LPar.Np,LPar.resid,LPar.MaxIt);
-        int Nconv = 0;
-        IRL.calc(eig[t].eval,eig[t].evec,src,Nconv);
-        if (Nconv < LPar.Nvec)
-        {
-            // NB: Can't assert here since we are processing local slices - i.e. not all nodes would assert
-            ConvergenceErrors = 1;
-            LOG(Error) << "MDistil::LapEvec : Not enough eigenvectors converged. If this occurs in practice, we should modify the eigensolver to iterate once more to ensure the second convergence test does not take us below the requested number of eigenvectors" << std::endl;
-        }
-        if( Nconv != LPar.Nvec )
-            eig[t].resize(LPar.Nvec, gridLD.get());
-        RotateEigen( eig[t].evec ); // Rotate the eigenvectors into our phase convention
+            Laplacian3DHerm<LatticeColourVector> NablaCheby(Cheb,Nabla);
+            ImplicitlyRestartedLanczos<LatticeColourVector>
+            IRL(NablaCheby,Nabla,LPar.Nvec,LPar.Nk,LPar.Nk+LPar.Np,LPar.resid,LPar.MaxIt);
+            int Nconv = 0;
+            IRL.calc(eig[t].eval,eig[t].evec,src,Nconv);
+            if (Nconv < LPar.Nvec)
+            {
+                // NB: Can't assert here since we are processing local slices - i.e. not all nodes would assert
+                ConvergenceErrors = 1;
+                LOG(Error) << "MDistil::LapEvec : Not enough eigenvectors converged. If this occurs in practice, we should modify the eigensolver to iterate once more to ensure the second convergence test does not take us below the requested number of eigenvectors" << std::endl;
+            }
+            if( Nconv != LPar.Nvec )
+                eig[t].resize(LPar.Nvec, gridLD.get());
+            RotateEigen( eig[t].evec ); // Rotate the eigenvectors into our phase convention
         
-        for (int i=0;i<LPar.Nvec;i++){
-            InsertSliceLocal(eig[t].evec[i],eig4d.evec[i],0,t,Tdir);
-            if(t==0 && Ntfirst==0)
-                eig4d.eval[i] = eig[t].eval[i]; // TODO: Discuss: is this needed? Is there a better way?
-            if(gridLD->IsBoss()) // Only do this on one node per timeslice, so a global sum will work
-                Evals.tensor(t + Ntfirst,i) = eig[t].eval[i];
+            for (int i=0;i<LPar.Nvec;i++){
+                InsertSliceLocal(eig[t].evec[i],eig4d.evec[i],0,t,Tdir);
+                if(t==0 && Ntfirst==0)
+                    eig4d.eval[i] = eig[t].eval[i]; // TODO: Discuss: is this needed? Is there a better way?
+                if(gridLD->IsBoss()) // Only do this on one node per timeslice, so a global sum will work
+                    Evals.tensor(t + Ntfirst,i) = eig[t].eval[i];
+            }
         }
     }
     GridLogIRL.Active( PreviousIRLLogState );
@@ -354,6 +381,83 @@ void TLapEvec<GImpl>::execute(void)
     }
 }
 
+/******************************************************************************
+ Time slices solved concurrently: the 3d grid is split so that each rank holds
+ a whole time slice, the local slices are processed in batches of one slice
+ per split grid, and each batch of eigenvectors is inserted into the 4d pack
+ as soon as it has converged
+ ******************************************************************************/
+
+template <typename GImpl>
+void TLapEvec<GImpl>::executeSliceParallel(LapEvecs &eig4d, GaugeField &Umu_smear,
+                                           TimesliceEvals &Evals, uint32_t &ConvergenceErrors)
+{
+    const ChebyshevParameters &ChebPar{par().Cheby};
+    const LanczosParameters   &LPar{par().Lanczos};
+    envGetTmp(std::vector<LatticeGaugeField>,   UmuBatch);
+    envGetTmp(std::vector<LatticeColourVector>, evecBatch);
+    envGetTmp(LatticeGaugeField,   UmuSplit);
+    envGetTmp(LatticeColourVector, srcSplit);
+    envGetTmp(LapEvecs,            eigSplit);
+    GridCartesian * gridHD = env().getGrid();
+    const int Ntlocal{gridHD->LocalDimensions()[Tdir]};
+    const int Ntfirst{gridHD->LocalStarts()[Tdir]};
+    const int nSplit{static_cast<int>(UmuBatch.size())};
+    std::vector<RealD> evalBatch(nSplit * LPar.Nvec);
+    LOG(Message) << "Solving " << nSplit << " time slices concurrently on split grid "
+                 << gridSplit->_processors << std::endl;
+    for (int t0 = 0; t0 < Ntlocal; t0 += nSplit )
+    {
+        const int nBatch{std::min(nSplit, Ntlocal - t0)};
+        LOG(Message) << "------------------------------------------------------------" << std::endl;
+        LOG(Message) << " Compute eigenpacks, local timeslices = " << t0 << " - "
+                     << t0 + nBatch - 1 << " / " << Ntlocal << std::endl;
+        LOG(Message) << "------------------------------------------------------------" << std::endl;
+        // Padding slices of the last batch repeat its last slice and are discarded
+        for (int b = 0; b < nSplit; b++)
+            ExtractSliceLocal(UmuBatch[b],Umu_smear,0,t0 + std::min(b, nBatch - 1),Tdir);
+        Grid_split(UmuBatch, UmuSplit);
+        eigSplit.resize(LPar.Nk+LPar.Np,gridSplit.get());
+        
+        Laplacian3D<LatticeColourVector> Nabla(UmuSplit);
+        Chebyshev<LatticeColourVector> Cheb(ChebPar.alpha,ChebPar.beta,ChebPar.PolyOrder);
+        srcSplit = 11.0; // NB: This is a dummy parameter and just needs to be non-zero
+        srcSplit = srcSplit * (1.0/Grid::sqrt(norm2(srcSplit)));
+        Laplacian3DHerm<LatticeColourVector> NablaCheby(Cheb,Nabla);
+        ImplicitlyRestartedLanczos<LatticeColourVector>
+        IRL(NablaCheby,Nabla,LPar.Nvec,LPar.Nk,LPar.Nk+LPar.Np,LPar.resid,LPar.MaxIt);
+        int Nconv = 0;
+        IRL.calc(eigSplit.eval,eigSplit.evec,srcSplit,Nconv);
+        if (Nconv < LPar.Nvec)
+        {
+            ConvergenceErrors = 1;
+            LOG(Error) << "MDistil::LapEvec : Not enough eigenvectors converged on split grid " << splitRank << std::endl;
+        }
+        if( Nconv != LPar.Nvec )
+            eigSplit.resize(LPar.Nvec, gridSplit.get());
+        RotateEigen( eigSplit.evec ); // Phase convention applied on each split grid
+        
+        // Each split grid only knows its own eigenvalues
+        for (auto &e : evalBatch)
+            e = 0;
+        if(gridSplit->IsBoss())
+            for (int i=0;i<LPar.Nvec;i++)
+                evalBatch[splitRank * LPar.Nvec + i] = eigSplit.eval[i];
+        gridLD->GlobalSumVector(evalBatch.data(), static_cast<int>(evalBatch.size()));
+        for (int i=0;i<LPar.Nvec;i++){
+            Grid_unsplit(evecBatch, eigSplit.evec[i]);
+            for (int b = 0; b < nBatch; b++){
+                const int t{t0 + b};
+                InsertSliceLocal(evecBatch[b],eig4d.evec[i],0,t,Tdir);
+                if(t==0 && Ntfirst==0)
+                    eig4d.eval[i] = evalBatch[b * LPar.Nvec + i];
+                if(gridLD->IsBoss()) // Only do this on one node per timeslice, so a global sum will work
+                    Evals.tensor(t + Ntfirst,i) = evalBatch[b * LPar.Nvec + i];
+            }
+        }
+    }
+}
+
 END_MODULE_NAMESPACE
 
 END_HADRONS_NAMESPACE
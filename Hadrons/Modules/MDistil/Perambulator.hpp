@@ -56,7 +56,8 @@ public:
                                     std::string, unsmearedSolve,
                                     pMode, perambMode,
                                     int, nVec,
-                                    std::string, DistilParams);
+                                    std::string, DistilParams,
+                                    unsigned int, batchSize);
 };
 
 template <typename FImpl>
@@ -76,8 +77,11 @@ public:
     virtual void setup(void);
     // execution
     virtual void execute(void);
+private:
+    void executeBatched(PerambTensor &perambulator,
+                        const std::vector<FermionField> &solveIn,
+                        const std::string &streamFileName);
 protected:
-    std::unique_ptr<GridCartesian> grid3d; // Owned by me, so I must delete it
     unsigned int Ls_;
 };
 
@@ -126,7 +130,6 @@ std::vector<std::string> TPerambulator<FImpl>::getOutput(void)
 template <typename FImpl>
 void TPerambulator<FImpl>::setup(void)
 {
-    MakeLowerDimGrid(grid3d, env().getGrid());
     const DistilParameters &dp = envGet(DistilParameters, par().DistilParams);
     const int  Nt{env().getDim(Tdir)};
 
@@ -143,14 +146,18 @@ void TPerambulator<FImpl>::setup(void)
     
     envTmpLat(FermionField,      "dist_source");
     envTmpLat(FermionField,      "fermion4dtmp");
-    envTmp(FermionField,         "fermion3dtmp", 1, grid3d.get());
-    envTmpLat(ColourVectorField, "cv4dtmp");
-    envTmp(ColourVectorField,    "cv3dtmp", 1, grid3d.get());
-    envTmp(ColourVectorField,    "evec3d",  1, grid3d.get());
     
     Ls_ = env().getObjectLs(par().solver);
     envTmpLat(FermionField, "v5dtmp", Ls_);
     envTmpLat(FermionField, "v5dtmp_sol", Ls_);
+    // batch buffers, input solves are read in place
+    if ((par().batchSize > 0) and (par().perambMode != pMode::inputSolve))
+    {
+        envTmp(std::vector<FermionField>, "sources", 1, par().batchSize,
+               envGetGrid(FermionField));
+        envTmp(std::vector<FermionField>, "solutions", 1, par().batchSize,
+               envGetGrid(FermionField));
+    }
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -171,13 +178,7 @@ void TPerambulator<FImpl>::execute(void)
     objName.append( "_unsmeared_solve" );
     envGetTmp(FermionField,      dist_source);
     envGetTmp(FermionField,      fermion4dtmp);
-    envGetTmp(FermionField,      fermion3dtmp);
-    envGetTmp(ColourVectorField, cv4dtmp);
-    envGetTmp(ColourVectorField, cv3dtmp);
-    envGetTmp(ColourVectorField, evec3d);
     GridCartesian * const grid4d{ env().getGrid() }; // Owned by environment (so I won't delete it)
-    const int Ntlocal{grid4d->LocalDimensions()[3]};
-    const int Ntfirst{grid4d->LocalStarts()[3]};
 
     pMode perambMode{par().perambMode};
     LOG(Message)<< "Mode " << perambMode << std::endl;
@@ -199,6 +200,29 @@ void TPerambulator<FImpl>::execute(void)
     }
     LOG(Message) << "Source times" << perambulator.MetaData.sourceTimes << std::endl;
 
+    std::string sPerambName {par().perambFileName};
+    sPerambName.append(".");
+    sPerambName.append(std::to_string(vm().getTrajectory()));
+#ifdef HAVE_HDF5
+    // batched mode appends each batch to a chunked file as soon as it is done
+    const bool streamPeramb{par().batchSize > 0};
+#else
+    const bool streamPeramb{false};
+#endif
+    if (par().batchSize > 0)
+    {
+        executeBatched(perambulator, solveIn, streamPeramb ? sPerambName : "");
+        if (grid4d->IsBoss() && !streamPeramb)
+        {
+            perambulator.write(sPerambName.c_str());
+        }
+        return;
+    }
+
+    const int projSize{dp.nvec*Ns*Nt};
+    std::vector<SpinVector> coef(Nt*dp.nvec);
+    std::vector<ComplexD>   proj(projSize);
+
     for (int inoise = 0; inoise < dp.nnoise; inoise++)
     {
         for (int dk = 0; dk < dp.LI; dk++)
@@ -214,9 +238,8 @@ void TPerambulator<FImpl>::execute(void)
 		    else 
 		    {
                         LOG(Message) <<  "LapH source vector from noise " << inoise << " and dilution component (d_k,d_t,d_alpha) : (" << dk << ","<< dt << "," << ds << ")" << std::endl;
-                        dist_source = 0;
-                        evec3d = 0;
-			DIST_SOURCE
+                        DistilSourceCoef(coef.data(), noise, dp, Nt, inoise, dk, dt, ds);
+                        localSliceLinearCombination(dist_source, epack.evec, dp.nvec, coef.data());
                         fermion4dtmp=0;
                         if (Ls_ == 1)
                             solver(fermion4dtmp, dist_source);
@@ -232,56 +255,158 @@ void TPerambulator<FImpl>::execute(void)
                             solveOut[inoise+dp.nnoise*(dk+dp.LI*(dt+dp.inversions*ds))] = fermion4dtmp;
                         }
 		    }
+                    // project on the Laplacian eigenvectors, one global sum for all slices
+                    proj.assign(projSize, 0.);
+                    localSliceInnerProductBlock(proj.data(), epack.evec, dp.nvec, fermion4dtmp);
+                    grid4d->GlobalSumVector(proj.data(), proj.size());
+                    for (int ivec = 0; ivec < dp.nvec; ivec++)
                     for (int is = 0; is < Ns; is++)
+                    for (int t = 0; t < Nt; t++)
                     {
-                        cv4dtmp = peekSpin(fermion4dtmp,is);
-                        for (int t = Ntfirst; t < Ntfirst + Ntlocal; t++)
-                        {
-                            ExtractSliceLocal(cv3dtmp,cv4dtmp,0,t-Ntfirst,Tdir); 
-			    for (int ivec = 0; ivec < dp.nvec; ivec++)
-                            {
-                                ExtractSliceLocal(evec3d,epack.evec[ivec],0,t-Ntfirst,Tdir);
-                                pokeSpin(perambulator.tensor(t, ivec, dk, inoise,dt,ds),static_cast<Complex>(innerProduct(evec3d, cv3dtmp)),is);
-                            }
-                        }
+                        pokeSpin(perambulator.tensor(t, ivec, dk, inoise, dt, ds),
+                                 static_cast<Complex>(proj[(ivec*Ns + is)*Nt + t]), is);
                     }
                 }
             }
         }
     }
-    // Now share my timeslice data with other members of the grid
-    const int NumSlices{grid4d->_processors[Tdir] / grid3d->_processors[Tdir]};
-    if (NumSlices > 1)
+    
+    // Save the perambulator to disk from the boss node
+    if (grid4d->IsBoss())
+    {
+        perambulator.write(sPerambName.c_str());
+    }
+}
+
+// batched execution ///////////////////////////////////////////////////////////
+// Dilution components are processed batchSize at a time: all the sources of a
+// batch are built, then solved, then projected on the Laplacian eigenvectors
+// with a blocked slice inner product. The projections of a batch are reduced
+// across the whole 4d grid with a single global sum.
+// If streamFileName is not empty, the perambulator file is created with one
+// chunk per dilution component and each batch is written as soon as it is
+// complete.
+template <typename FImpl>
+void TPerambulator<FImpl>::executeBatched(PerambTensor &perambulator,
+                                          const std::vector<FermionField> &solveIn,
+                                          const std::string &streamFileName)
+{
+    const DistilParameters &dp{ envGet(DistilParameters, par().DistilParams) };
+    const int Nt{env().getDim(Tdir)};
+
+    auto &solver=envGet(Solver, par().solver);
+    auto &mat = solver.getFMat();
+    auto &noise = envGet(NoiseTensor, par().noise);
+    auto &epack = envGet(LapEvecs, par().lapevec);
+    envGetTmp(FermionField,      v5dtmp);
+    envGetTmp(FermionField,      v5dtmp_sol);
+    GridCartesian * const grid4d{ env().getGrid() };
+
+    pMode perambMode{par().perambMode};
+    std::vector<FermionField> *sourcesPt = nullptr, *solutionsPt = nullptr;
+    if(perambMode != pMode::inputSolve)
+    {
+        envGetTmp(std::vector<FermionField>, sources);
+        envGetTmp(std::vector<FermionField>, solutions);
+        sourcesPt   = &sources;
+        solutionsPt = &solutions;
+    }
+    const std::string solveName{getName() + "_unsmeared_solve"};
+    const int nComp{dp.nnoise*dp.LI*dp.inversions*dp.SI};
+    const int batchSize{static_cast<int>(par().batchSize)};
+    const int projSize{dp.nvec*Ns*Nt};
+    std::vector<int>      inoiseB(batchSize), dkB(batchSize), dtB(batchSize), dsB(batchSize);
+    std::vector<ComplexD> proj;
+    std::vector<const FermionField *> solPt;
+    std::vector<SpinVector> coef(Nt*dp.nvec);
+
+    LOG(Message) << "Batched perambulator: " << nComp << " dilution components in batches of "
+                 << batchSize << std::endl;
+    const bool stream{!streamFileName.empty()};
+    if (stream && grid4d->IsBoss())
+    {
+        perambulator.initChunkedFile(streamFileName, {Nt, dp.nvec, 1, 1, 1, 1});
+    }
+    for (int c0 = 0; c0 < nComp; c0 += batchSize)
     {
-        LOG(Debug) <<  "Sharing perambulator data with other nodes" << std::endl;
-        const int MySlice {grid4d->_processor_coor[Tdir]};
-        const int TensorSize {static_cast<int>(perambulator.tensor.size() * PerambTensor::Traits::count)};
-        assert (TensorSize == perambulator.tensor.size() * PerambTensor::Traits::count && "peramb size overflow");
-        const int SliceCount {TensorSize/NumSlices};
-        using InnerScalar = typename PerambTensor::Traits::scalar_type;
-        InnerScalar * const PerambData {EigenIO::getFirstScalar( perambulator.tensor )};
-        // Zero data for all timeslices other than the slice computed by 3d boss nodes
-        for (int Slice = 0 ; Slice < NumSlices ; ++Slice)
+        const int nb{std::min(batchSize, nComp - c0)};
+
+        // same component ordering as the unbatched loops (ds fastest)
+        for (int b = 0; b < nb; b++)
         {
-            if (!grid3d->IsBoss() || Slice != MySlice)
+            int c = c0 + b;
+
+            dsB[b]     = c % dp.SI;         c /= dp.SI;
+            dtB[b]     = c % dp.inversions; c /= dp.inversions;
+            dkB[b]     = c % dp.LI;         c /= dp.LI;
+            inoiseB[b] = c;
+        }
+        if(perambMode != pMode::inputSolve)
+        {
+            auto &sources   = *sourcesPt;
+            auto &solutions = *solutionsPt;
+
+            startTimer("Distillation sources");
+            for (int b = 0; b < nb; b++)
             {
-                InnerScalar * const SliceData {PerambData + Slice * SliceCount};
-                for (int j = 0 ; j < SliceCount ; ++j)
+                const int inoise{inoiseB[b]}, dk{dkB[b]}, dt{dtB[b]}, ds{dsB[b]};
+
+                LOG(Message) <<  "LapH source vector from noise " << inoise << " and dilution component (d_k,d_t,d_alpha) : (" << dk << ","<< dt << "," << ds << ")" << std::endl;
+                DistilSourceCoef(coef.data(), noise, dp, Nt, inoise, dk, dt, ds);
+                localSliceLinearCombination(sources[b], epack.evec, dp.nvec, coef.data());
+            }
+            stopTimer("Distillation sources");
+            startTimer("Solver");
+            for (int b = 0; b < nb; b++)
+            {
+                solutions[b] = 0;
+                if (Ls_ == 1)
+                    solver(solutions[b], sources[b]);
+                else
+                {
+                    mat.ImportPhysicalFermionSource(sources[b], v5dtmp);
+                    solver(v5dtmp_sol, v5dtmp);
+                    mat.ExportPhysicalFermionSolution(v5dtmp_sol, solutions[b]);
+                }
+                if(perambMode == pMode::outputSolve)
                 {
-                    SliceData[j] = 0.;
+                    auto &solveOut = envGet(std::vector<FermionField>, solveName);
+                    solveOut[inoiseB[b]+dp.nnoise*(dkB[b]+dp.LI*(dtB[b]+dp.inversions*dsB[b]))] = solutions[b];
                 }
             }
+            stopTimer("Solver");
+        }
+        startTimer("Projection");
+        proj.assign(nb*projSize, 0.);
+        solPt.resize(nb);
+        for (int b = 0; b < nb; b++)
+        {
+            solPt[b] = (perambMode == pMode::inputSolve) ?
+                &solveIn[inoiseB[b]+dp.nnoise*(dkB[b]+dp.LI*(dtB[b]+dp.inversions*dsB[b]))] :
+                &(*solutionsPt)[b];
+        }
+        // one pass over the eigenvectors for the whole batch
+        localSliceInnerProductBlock(proj.data(), epack.evec, dp.nvec, solPt);
+        grid4d->GlobalSumVector(proj.data(), proj.size());
+        for (int b = 0; b < nb; b++)
+        for (int ivec = 0; ivec < dp.nvec; ivec++)
+        for (int is = 0; is < Ns; is++)
+        for (int t = 0; t < Nt; t++)
+        {
+            pokeSpin(perambulator.tensor(t, ivec, dkB[b], inoiseB[b], dtB[b], dsB[b]),
+                     static_cast<Complex>(proj[b*projSize + (ivec*Ns + is)*Nt + t]), is);
+        }
+        stopTimer("Projection");
+        if (stream && grid4d->IsBoss())
+        {
+            startTimer("Perambulator I/O");
+            for (int b = 0; b < nb; b++)
+            {
+                perambulator.writeBlock(streamFileName, {0, 0, dkB[b], inoiseB[b], dtB[b], dsB[b]},
+                                        {Nt, dp.nvec, 1, 1, 1, 1});
+            }
+            stopTimer("Perambulator I/O");
         }
-        grid4d->GlobalSumVector(PerambData, TensorSize);
-    }
-    
-    // Save the perambulator to disk from the boss node
-    if (grid4d->IsBoss())
-    {
-        std::string sPerambName {par().perambFileName};
-        sPerambName.append(".");
-        sPerambName.append(std::to_string(vm().getTrajectory()));
-        perambulator.write(sPerambName.c_str());
     }
 }
 
@@ -48,7 +48,8 @@ public:
                                     bool, multiFile,
                                     unsigned int, size,
                                     unsigned int, Ls,
-                                    std::string, gaugeXform);
+                                    std::string, gaugeXform,
+                                    unsigned int, ioGroups);
 };
 
 template <typename Pack, typename GImpl>
@@ -148,9 +149,34 @@ void TLoadEigenPack<Pack, GImpl>::setup(void)
 template <typename Pack, typename GImpl>
 void TLoadEigenPack<Pack, GImpl>::execute(void)
 {
-    auto &epack = envGetDerived(BasePack, Pack, getName());
+    auto   &epack = envGetDerived(BasePack, Pack, getName());
+    double size, ioTime;
 
-    epack.read(par().filestem, par().multiFile, vm().getTrajectory());
+    ioTime = -getDTimer("Read");
+    startTimer("Read");
+    if (par().multiFile and (par().ioGroups > 1))
+    {
+        GridCartesian *gridIo = nullptr;
+
+        if (typeHash<Field>() != typeHash<FieldIo>())
+        {
+            gridIo = envGetGrid(FieldIo, par().Ls);
+        }
+        epack.readGroups(par().filestem, par().ioGroups, 
+                         envGetGrid(Field, par().Ls), gridIo, 
+                         vm().getTrajectory());
+    }
+    else
+    {
+        epack.read(par().filestem, par().multiFile, vm().getTrajectory());
+    }
+    stopTimer("Read");
+    size = static_cast<double>(par().size)*epack.evec[0].Grid()->gSites()
+           *sizeof(typename FieldIo::scalar_object);
+    ioTime += getDTimer("Read");
+    LOG(Message) << "Eigenpack read: " << sizeString(size) << " in " 
+                 << ioTime/1.0e6 << " s (" << size/ioTime*1.0e6/1024/1024/1024 
+                 << " GB/s)" << std::endl;
     epack.eval.resize(par().size);
 
     if (!par().gaugeXform.empty())
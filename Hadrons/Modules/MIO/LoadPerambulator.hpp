@@ -47,7 +47,10 @@ class LoadPerambulatorPar: Serializable
 public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(LoadPerambulatorPar,
                                         std::string, PerambFileName,
-                                        std::string, DistilParams);
+                                        std::string, DistilParams,
+                                        unsigned int, tFirst,
+                                        unsigned int, nt,
+                                        unsigned int, nvec);
 };
 
 template <typename FImpl>
@@ -97,7 +100,10 @@ void TLoadPerambulator<FImpl>::setup(void)
     const int Nt{env().getDim(Tdir)}; 
     const bool full_tdil{ dp.TI == Nt };
     const int Nt_inv{ full_tdil ? 1 : dp.TI };
-    envCreate(MDistil::PerambTensor, getName(), 1, Nt,dp.nvec,dp.LI,dp.nnoise,Nt_inv,dp.SI);
+    // optionally only load the sink times [tFirst, tFirst + nt) and the first nvec vectors
+    const int nt{ par().nt ? static_cast<int>(par().nt) : Nt };
+    const int nvec{ par().nvec ? static_cast<int>(par().nvec) : dp.nvec };
+    envCreate(MDistil::PerambTensor, getName(), 1, nt,nvec,dp.LI,dp.nnoise,Nt_inv,dp.SI);
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -108,7 +114,17 @@ void TLoadPerambulator<FImpl>::execute(void)
   std::string sPerambName{ par().PerambFileName };
   sPerambName.append( 1, '.' );
   sPerambName.append( std::to_string( vm().getTrajectory() ) );
-  perambulator.read(sPerambName.c_str());
+  if (par().tFirst || par().nt || par().nvec)
+  {
+      LOG(Message) << "Loading perambulator block t = [" << par().tFirst << ", "
+                   << par().tFirst + perambulator.tensor.dimension(0) << "), nvec = "
+                   << perambulator.tensor.dimension(1) << std::endl;
+      perambulator.readBlock(sPerambName, {par().tFirst, 0, 0, 0, 0, 0});
+  }
+  else
+  {
+      perambulator.read(sPerambName.c_str());
+  }
 }
 
 END_MODULE_NAMESPACE
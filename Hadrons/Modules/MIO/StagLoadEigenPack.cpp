@@ -34,4 +34,5 @@ using namespace MIO;
 template class Grid::Hadrons::MIO::TStagLoadEigenPack<FermionEigenPack<STAGIMPL>, GIMPL, STAGIMPL>;
 #ifdef GRID_DEFAULT_PRECISION_DOUBLE
 template class Grid::Hadrons::MIO::TStagLoadEigenPack<FermionEigenPack<STAGIMPL, STAGIMPLF>, GIMPL, STAGIMPL>;
+template class Grid::Hadrons::MIO::TStagLoadEigenPack<FermionEigenPack<STAGIMPLF>, GIMPLF, STAGIMPLF>;
 #endif
@@ -86,6 +86,8 @@ MODULE_REGISTER_TMP(StagLoadFermionEigenPack, ARG(TStagLoadEigenPack<FermionEige
 #ifdef GRID_DEFAULT_PRECISION_DOUBLE
 MODULE_REGISTER_TMP(StagLoadFermionEigenPackIo32, 
                     ARG(TStagLoadEigenPack<FermionEigenPack<STAGIMPL,STAGIMPLF>, GIMPL, STAGIMPL>), MIO);
+MODULE_REGISTER_TMP(StagLoadFermionEigenPackF, 
+                    ARG(TStagLoadEigenPack<FermionEigenPack<STAGIMPLF>, GIMPLF, STAGIMPLF>), MIO);
 #endif
 
 /******************************************************************************
@@ -187,7 +189,7 @@ void TStagLoadEigenPack<Pack, GImpl, FImpl>::execute(void)
             epack.evec[i].Checkerboard() = Odd;
             action.Meooe(epack.evec[i], temp);
             cc = minusI/eval;
-            epack.evec[i] = cc * temp; // now it's even!
+            epack.evec[i] = static_cast<typename Field::scalar_type>(cc) * temp; // now it's even!
             epack.evec[i].Checkerboard() = Even;
         }
     } else {
@@ -56,6 +56,115 @@ public:
                                     std::string,    output);
 };
 
+/******************************************************************************
+ *                     Fused four-quark vertex kernel                         *
+ ******************************************************************************/
+// All the vertices
+//   V_{mu,nu} = sum_x B_mu(x) (x) B_nu(x),  B_g = g5*adj(Sout)*g5*G_g*Sin
+// are computed in a single sweep over the local sites. Flattening the 144
+// spin-colour indices of the bilinears, a block of sites gives a matrix X
+// (one row per scalar site, one column per (g, spin-colour) pair) and the
+// vertices are the blocks of X^T X. The bilinears of all gammas are built
+// once per site, X^T X is accumulated blockwise by the threads, each owning
+// a set of rows of the result, and a single global sum completes the
+// reduction. With diagonal = true only the V_{g,g} blocks are computed.
+// The result layout is ((mu*nGamma + nu)*nsc + a)*nsc + b, with
+// a = ((si*Ns + sj)*Nc + ci)*Nc + cj for B_mu and the same for b and B_nu.
+#ifndef HADRONS_NPR_SITE_BLOCK
+#define HADRONS_NPR_SITE_BLOCK 64
+#endif
+
+template <typename PropagatorField1, typename PropagatorField2>
+void fourQuarkVertices(std::vector<ComplexD> &res, const PropagatorField1 &Sin,
+                       const PropagatorField2 &Sout,
+                       const std::vector<Gamma> &gammaList, const bool diagonal)
+{
+    typedef typename PropagatorField1::vector_object vobj;
+    typedef typename vobj::scalar_type               Scalar;
+    typedef typename vobj::vector_type               Vector;
+    typedef Eigen::Matrix<ComplexD, -1, -1, Eigen::RowMajor> Mat;
+
+    GridBase           *grid  = Sin.Grid();
+    const int          nsc    = Ns*Ns*Nc*Nc;
+    const int          nGam   = gammaList.size();
+    const int          nCol   = nGam*nsc;
+    const int          Nsimd  = grid->Nsimd();
+    const int          osites = grid->oSites();
+    const int          oBlock = HADRONS_NPR_SITE_BLOCK;
+    const int          nRes   = diagonal ? nGam : nGam*nGam;
+    Gamma              g5(Gamma::Algebra::Gamma5);
+    Mat                X(oBlock*Nsimd, nCol), V(diagonal ? nsc : nCol, nCol);
+
+    static_assert(sizeof(vobj) == Ns*Ns*Nc*Nc*sizeof(Vector),
+                  "propagator site object is not a spin-colour matrix");
+    res.assign(nRes*nsc*nsc, 0.);
+    V.setZero();
+    autoView(sin_v, Sin, CpuRead);
+    autoView(sout_v, Sout, CpuRead);
+    for (int ss0 = 0; ss0 < osites; ss0 += oBlock)
+    {
+        const int nb = std::min(oBlock, osites - ss0);
+
+        // bilinears of all gammas on the block, one row per scalar site
+        thread_for(i, nb,
+        {
+            const int  ss = ss0 + i;
+            const vobj w  = g5*adj(sout_v[ss])*g5;
+            vobj       bil;
+
+            for (int g = 0; g < nGam; ++g)
+            {
+                bil = w*(gammaList[g]*sin_v[ss]);
+
+                const Scalar *lane = reinterpret_cast<const Scalar *>(&bil);
+
+                for (int a = 0; a < nsc; ++a)
+                for (int idx = 0; idx < Nsimd; ++idx)
+                {
+                    X(i*Nsimd + idx, g*nsc + a) = lane[a*Nsimd + idx];
+                }
+            }
+        });
+        // accumulate X^T X, each thread owns a set of rows of the result
+        const int nRow = nb*Nsimd;
+
+        if (diagonal)
+        {
+            thread_for(g, nGam,
+            {
+                auto Xg = X.block(0, g*nsc, nRow, nsc);
+
+                V.block(0, g*nsc, nsc, nsc).noalias() += Xg.transpose()*Xg;
+            });
+        }
+        else
+        {
+            thread_for(g, nGam,
+            {
+                V.block(g*nsc, 0, nsc, nCol).noalias() +=
+                    X.block(0, g*nsc, nRow, nsc).transpose()*X.topRows(nRow);
+            });
+        }
+    }
+    for (int mu = 0; mu < nGam; ++mu)
+    for (int nu = 0; nu < nGam; ++nu)
+    {
+        if (diagonal and (mu != nu))
+        {
+            continue;
+        }
+
+        const int r = diagonal ? mu : mu*nGam + nu;
+
+        for (int a = 0; a < nsc; ++a)
+        for (int b = 0; b < nsc; ++b)
+        {
+            res[(r*nsc + a)*nsc + b] = V(diagonal ? a : mu*nsc + a, nu*nsc + b);
+        }
+    }
+    grid->GlobalSumVector(res.data(), res.size());
+}
+
 template <typename FImpl1, typename FImpl2>
 class TFourQuark: public Module<FourQuarkPar>
 {
@@ -77,7 +186,6 @@ public:
     virtual std::vector<std::string> getInput(void);
     virtual std::vector<std::string> getOutput(void);
     // setup
-    virtual void tensorprod(LatticeSpinColourSpinColourMatrix &lret, LatticeSpinColourMatrix a, LatticeSpinColourMatrix b);
     virtual void setup(void);
     // execution
     virtual void execute(void);
@@ -112,39 +220,6 @@ std::vector<std::string> TFourQuark<FImpl1, FImpl2>::getOutput(void)
 }
 
 
-template <typename FImpl1, typename FImpl2>
-void TFourQuark<FImpl1, FImpl2>::tensorprod(LatticeSpinColourSpinColourMatrix &lret, LatticeSpinColourMatrix a, LatticeSpinColourMatrix b)
-{
-            // FIXME ; is there a general need for this construct ? In which case we should encapsulate the
-            //         below loops in a helper function.
-            //LOG(Message) << "sp co mat a is - " << a << std::endl;
-            //LOG(Message) << "sp co mat b is - " << b << std::endl;
-	    autoView(lret_v, lret, CpuWrite);
-	    autoView(a_v, a, CpuRead);
-	    autoView(b_v, b, CpuRead);
-#ifdef GRID_NVCC
-#warning "NVCC problem: Removed impossibly slow compile of simple NPR host code in FourQuark.hpp"
-#else
-            thread_foreach( site,lret_v,{
-		vTComplex left;
-                for(int si=0; si < Ns; ++si){
-                for(int sj=0; sj < Ns; ++sj){
-                    for (int ci=0; ci < Nc; ++ci){
-                    for (int cj=0; cj < Nc; ++cj){
-                      //LOG(Message) << "si, sj, ci, cj -  " << si << ", " << sj  << ", "<< ci  << ", "<< cj << std::endl;
-                      left()()() = a_v[site]()(si,sj)(ci,cj);
-                      //LOG(Message) << left << std::endl;
-                      lret_v[site]()(si,sj)(ci,cj)=left()*b_v[site]();
-                    }}
-                }}
-	      });
-#endif
-}
-
-
-
-
-
 // setup ///////////////////////////////////////////////////////////////////////
 template <typename FImpl1, typename FImpl2>
 void TFourQuark<FImpl1, FImpl2>::setup(void)
@@ -169,6 +244,7 @@ We then find the outer product of V1 and V2, keeping the spin and colour indices
 Then this is summed over the lattice coordinate
 Result is a SpinColourSpinColourMatrix - with 4 colour and 4 spin indices. 
 We have up to 256 of these including the offdiag (G1 != G2).
+All of them are computed in a single pass over the sites by fourQuarkVertices.
 
         \         /
          \p1   p1/
@@ -199,8 +275,7 @@ We have up to 256 of these including the offdiag (G1 != G2).
     Result                                      result;
     std::vector<Real>                           latt_size(pin.begin(), pin.end());
     LatticeComplex                              pdotxin(env().getGrid()), pdotxout(env().getGrid()), coor(env().getGrid());
-    LatticeSpinColourMatrix                     bilinear_mu(env().getGrid()), bilinear_nu(env().getGrid());
-    LatticeSpinColourSpinColourMatrix           lret(env().getGrid()); 
+    std::vector<ComplexD>                       vertex;
     Complex                         Ci(0.0,1.0);
 
     //Phase propagators
@@ -227,29 +302,29 @@ We have up to 256 of these including the offdiag (G1 != G2).
          gammavector.push_back(Gamma(gam));
        }
     
-    lret = Zero();
-    if (fullbasis == true){ // all combinations of mu and nu
-        result.fourquark.resize(Gamma::nGamma/2*Gamma::nGamma/2);
-        for( int mu=0; mu<Gamma::nGamma/2; mu++){ 
-            bilinear_mu = g5*adj(Sout)*g5*gammavector[mu]*Sin;
-            for ( int nu=0; nu<Gamma::nGamma; nu++){
-                LatticeSpinColourMatrix     bilinear_nu(env().getGrid());
-                bilinear_nu = g5*adj(Sout)*g5*gammavector[nu]*Sin;
-                LOG(Message) << "bilinear_nu for nu = " << nu << " is - " << bilinear_mu << std::endl;
-                result.fourquark[mu*Gamma::nGamma/2 + nu] = Zero();
-                tensorprod(lret,bilinear_mu,bilinear_nu);
-                result.fourquark[mu*Gamma::nGamma/2 + nu] = sum(lret);
-            }
-        }
-    } else {
-        result.fourquark.resize(Gamma::nGamma/2);
-        for ( int mu=0; mu<1; mu++){
-        //for( int mu=0; mu<Gamma::nGamma/2; mu++ ){
-            bilinear_mu = g5*adj(Sout)*g5*gammavector[mu]*Sin;
-            //LOG(Message) << "bilinear_mu for mu = " << mu << " is - " << bilinear_mu << std::endl;
-            result.fourquark[mu] = Zero();
-            tensorprod(lret,bilinear_mu,bilinear_mu); //tensor outer product
-            result.fourquark[mu] = sum(lret);
+    // fullbasis: all combinations of mu and nu, otherwise mu = nu only
+    const unsigned int nGam = gammavector.size();
+    const unsigned int nsc  = Ns*Ns*Nc*Nc;
+
+    fourQuarkVertices(vertex, Sin, Sout, gammavector, !fullbasis);
+    result.fourquark.resize(fullbasis ? nGam*nGam : nGam);
+    for (unsigned int r = 0; r < result.fourquark.size(); ++r)
+    {
+        auto &v = result.fourquark[r];
+
+        for (int si = 0; si < Ns; ++si)
+        for (int sj = 0; sj < Ns; ++sj)
+        for (int ci = 0; ci < Nc; ++ci)
+        for (int cj = 0; cj < Nc; ++cj)
+        for (int sk = 0; sk < Ns; ++sk)
+        for (int sl = 0; sl < Ns; ++sl)
+        for (int ck = 0; ck < Nc; ++ck)
+        for (int cl = 0; cl < Nc; ++cl)
+        {
+            const unsigned int a = ((si*Ns + sj)*Nc + ci)*Nc + cj;
+            const unsigned int b = ((sk*Ns + sl)*Nc + ck)*Nc + cl;
+
+            v()(si, sj)(ci, cj)(sk, sl)(ck, cl) = vertex[(r*nsc + a)*nsc + b];
         }
     }
     write(writer, "fourquark", result.fourquark);
@@ -44,7 +44,8 @@ class CheckerboardSpinColorDiagonalPar: Serializable
 public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(CheckerboardSpinColorDiagonalPar,
                                     unsigned int, nsrc,
-                                    unsigned int, nsparse);
+                                    unsigned int, nsparse,
+                                    bool, counterBased);
 };
 
 template <typename FImpl>
@@ -101,7 +102,7 @@ void TCheckerboardSpinColorDiagonal<FImpl>::setup(void)
 {
     envCreateDerived(SpinColorDiagonalNoise<FImpl>, 
                      CheckerboardNoise<FImpl>,
-                     getName(), 1, envGetGrid(FermionField), par().nsrc, par().nsparse);
+                     getName(), 1, envGetGrid(FermionField), par().nsrc, par().nsparse, par().counterBased);
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -112,7 +113,14 @@ void TCheckerboardSpinColorDiagonal<FImpl>::execute(void)
     LOG(Message) << "Generating checkerboard spin-color diagonal noise with" 
                  << " nsrc = " << par().nsrc
                  << " and nSparse = " << par().nsparse << std::endl;
-    noise.generateNoise(rng4d());
+    if (par().counterBased)
+    {
+        noise.generateNoise(counterSeed());
+    }
+    else
+    {
+        noise.generateNoise(rng4d());
+    }
 }
 
 END_MODULE_NAMESPACE
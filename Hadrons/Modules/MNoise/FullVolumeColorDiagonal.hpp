@@ -46,7 +46,8 @@ class FullVolumeColorDiagonalPar: Serializable
 {
 public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(FullVolumeColorDiagonalPar,
-                                    unsigned int, nsrc);
+                                    unsigned int, nsrc,
+                                    bool, counterBased);
 };
 
 template <typename FImpl>
@@ -102,7 +103,7 @@ void TFullVolumeColorDiagonal<FImpl>::setup(void)
 {
     envCreateDerived(ColorDiagonalNoise<FImpl>,
                      StagFullVolumeNoise<FImpl>,
-                     getName(), 1, envGetGrid(FermionField), par().nsrc);
+                     getName(), 1, envGetGrid(FermionField), par().nsrc, par().counterBased);
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -111,7 +112,14 @@ void TFullVolumeColorDiagonal<FImpl>::execute(void)
 {
     auto &noise = envGet(ColorDiagonalNoise<FImpl>, getName());
     LOG(Message) << "Generating full volume, color diagonal noise" << std::endl;
-    noise.generateNoise(rng4d());
+    if (par().counterBased)
+    {
+        noise.generateNoise(counterSeed());
+    }
+    else
+    {
+        noise.generateNoise(rng4d());
+    }
 }
 
 END_MODULE_NAMESPACE
@@ -46,7 +46,8 @@ class FullVolumeSpinColorDiagonalPar: Serializable
 {
 public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(FullVolumeSpinColorDiagonalPar,
-                                    unsigned int, nsrc);
+                                    unsigned int, nsrc,
+                                    bool, counterBased);
 };
 
 template <typename FImpl>
@@ -103,7 +104,7 @@ void TFullVolumeSpinColorDiagonal<FImpl>::setup(void)
 {
     envCreateDerived(SpinColorDiagonalNoise<FImpl>, 
                      FullVolumeNoise<FImpl>,
-                     getName(), 1, envGetGrid(FermionField), par().nsrc);
+                     getName(), 1, envGetGrid(FermionField), par().nsrc, par().counterBased);
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -112,7 +113,14 @@ void TFullVolumeSpinColorDiagonal<FImpl>::execute(void)
 {
     auto &noise = envGet(SpinColorDiagonalNoise<FImpl>, getName());
     LOG(Message) << "Generating full volume, spin-color diagonal noise" << std::endl;
-    noise.generateNoise(rng4d());
+    if (par().counterBased)
+    {
+        noise.generateNoise(counterSeed());
+    }
+    else
+    {
+        noise.generateNoise(rng4d());
+    }
 }
 
 END_MODULE_NAMESPACE
@@ -45,7 +45,8 @@ class SparseSpinColorDiagonalPar: Serializable
 public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(SparseSpinColorDiagonalPar,
                                     unsigned int, nsrc,
-                                    unsigned int, nsparse);
+                                    unsigned int, nsparse,
+                                    bool, counterBased);
 };
 
 template <typename FImpl>
@@ -102,7 +103,7 @@ void TSparseSpinColorDiagonal<FImpl>::setup(void)
 {
     envCreateDerived(SpinColorDiagonalNoise<FImpl>, 
                      SparseNoise<FImpl>,
-                     getName(), 1, envGetGrid(FermionField), par().nsrc, par().nsparse);    
+                     getName(), 1, envGetGrid(FermionField), par().nsrc, par().nsparse, par().counterBased);    
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -113,7 +114,14 @@ void TSparseSpinColorDiagonal<FImpl>::execute(void)
     LOG(Message) << "Generating sparse spin-color diagonal noise with" 
                  << " nsrc = " << par().nsrc
                  << " and nSparse = " << par().nsparse << std::endl;
-    noise.generateNoise(rng4d());
+    if (par().counterBased)
+    {
+        noise.generateNoise(counterSeed());
+    }
+    else
+    {
+        noise.generateNoise(rng4d());
+    }
 }
 
 END_MODULE_NAMESPACE
@@ -44,7 +44,8 @@ class TimeDilutedColorDiagonalPar: Serializable
 {
 public:
     GRID_SERIALIZABLE_CLASS_MEMBERS(TimeDilutedColorDiagonalPar,
-                                    unsigned int, numSrc);
+                                    unsigned int, numSrc,
+                                    bool, counterBased);
 };
 template <typename FImpl>
 class TTimeDilutedColorDiagonal: public Module<TimeDilutedColorDiagonalPar>
@@ -98,7 +99,7 @@ void TTimeDilutedColorDiagonal<FImpl>::setup(void)
 {
     envCreateDerived(ColorDiagonalNoise<FImpl>,
                      StagTimeDilutedNoise<FImpl>,
-                     getName(), 1, envGetGrid(FermionField), par().numSrc);
+                     getName(), 1, envGetGrid(FermionField), par().numSrc, par().counterBased);
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -108,7 +109,14 @@ void TTimeDilutedColorDiagonal<FImpl>::execute(void)
     auto &noise = envGet(ColorDiagonalNoise<FImpl>, getName());
 
     LOG(Message) << "Generating time-diluted, -color diagonal noise, num srcs= " << noise.size() << std::endl;
-    noise.generateNoise(rng4d());
+    if (par().counterBased)
+    {
+        noise.generateNoise(counterSeed());
+    }
+    else
+    {
+        noise.generateNoise(rng4d());
+    }
 #if 0
     for(int i=0;i<noise.fermSize();i++){
         LOG(Message) << noise.getFerm(i) << std::endl;
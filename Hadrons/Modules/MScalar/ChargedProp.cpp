@@ -68,7 +68,6 @@ void TChargedProp::setup(void)
     propQName_ = getName() + "_Q";
     propSunName_ = getName() + "_Sun";
     propTadName_ = getName() + "_Tad";
-    fftName_   = getName() + "_fft";
 
     freeMomPropDone_ = env().hasCreatedObject(freeMomPropName_);
     GFSrcDone_       = env().hasCreatedObject(GFSrcName_);
@@ -88,7 +87,8 @@ void TChargedProp::setup(void)
     envTmpLat(ScalarField, "buf");
     envTmpLat(ScalarField, "result");
     envTmpLat(ScalarField, "Amu");
-    envCache(FFT, fftName_, 1, env().getGrid());
+    envTmpLat(FftPackedField, "fftPacked");
+    envTmpLat(FftPackedField, "fftPackedFt");
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -109,89 +109,93 @@ void TChargedProp::execute(void)
 	auto   &propTad = envGet(ScalarField, propTadName_);
     auto   &GFSrc   = envGet(ScalarField, GFSrcName_);
     auto   &G       = envGet(ScalarField, freeMomPropName_);
-    auto   &fft     = envGet(FFT, fftName_);
     double q        = par().charge;
+    unsigned int     nd = env().getNd();
+    std::vector<int> tMask(nd, 0);
     envGetTmp(ScalarField, buf);
+    envGetTmp(FftPackedField, fftPacked);
+    envGetTmp(FftPackedField, fftPackedFt);
+
+    tMask[nd - 1] = 1;
+
+    auto &fft      = env().getFft().getTransform(env().getGrid(), std::vector<int>(nd, 1));
+    auto &tFft     = env().getFft().getTransform(env().getGrid(), tMask);
+    auto &spaceFft = env().getFft().getSpatialTransform(env().getGrid());
 
     // -G*momD1*G*F*Src (momD1 = F*D1*Finv)
     propQ = GFSrc;
     momD1(propQ, fft);
     propQ = -G*propQ;
     propSun = -propQ;
-    fft.FFT_dim(propQ, propQ, env().getNd()-1, FFT::backward);
 
     // G*momD1*G*momD1*G*F*Src (here buf = G*momD1*G*F*Src)
     momD1(propSun, fft);
     propSun = G*propSun;
-    fft.FFT_dim(propSun, propSun, env().getNd()-1, FFT::backward);
 
     // -G*momD2*G*F*Src (momD2 = F*D2*Finv)
     propTad = GFSrc;
     momD2(propTad, fft);
     propTad = -G*propTad;
-    fft.FFT_dim(propTad, propTad, env().getNd()-1, FFT::backward);
+
+    // all time FFTs in one batch
+    tFft(std::vector<ScalarField *>{&propQ, &propSun, &propTad, &buf},
+         std::vector<const ScalarField *>{&propQ, &propSun, &propTad, &GFSrc},
+         FFT::backward, fftPacked, fftPackedFt);
     
     // full charged scalar propagator
-    fft.FFT_dim(buf, GFSrc, env().getNd()-1, FFT::backward);
     prop = buf + q*propQ + q*q*propSun + q*q*propTad;
 
     // OUTPUT IF NECESSARY
     if (!par().output.empty())
     {
-        Result result;
-        TComplex            site;
-        std::vector<int>    siteCoor;
+        Result                        result;
+        std::vector<TComplex>         site;
+        std::vector<std::vector<int>> mom;
+        const unsigned int            nt   = env().getGrid()->FullDimensions()[nd - 1];
+        const unsigned int            nMom = par().outputMom.size();
 
         LOG(Message) << "Saving momentum-projected propagator to '"
                      << resultFilename(par().output) << "'..."
                      << std::endl;
-        result.projection.resize(par().outputMom.size());
+        result.projection.resize(nMom);
         result.lattice_size = env().getGrid()->FullDimensions().toVector();
         result.mass = par().mass;
         result.charge = q;
-        siteCoor.resize(env().getNd());
-        for (unsigned int i_p = 0; i_p < par().outputMom.size(); ++i_p)
+        for (unsigned int i_p = 0; i_p < nMom; ++i_p)
         {
             result.projection[i_p].momentum = strToVec<int>(par().outputMom[i_p]);
+            mom.push_back(result.projection[i_p].momentum);
+            mom.back().resize(nd - 1);
+        }
+        LOG(Message) << "Calculating " << nMom << " momentum projection(s)" 
+                     << std::endl;
+        FftService::gatherMomenta(site, 
+            std::vector<const ScalarField *>{&prop, &buf, &propQ, &propSun, &propTad},
+            mom);
+        for (unsigned int i_p = 0; i_p < nMom; ++i_p)
+        {
+            auto &proj = result.projection[i_p];
 
-            LOG(Message) << "Calculating (" << par().outputMom[i_p]
-                         << ") momentum projection" << std::endl;
-
-            result.projection[i_p].corr_0.resize(env().getGrid()->FullDimensions()[env().getNd()-1]);
-            result.projection[i_p].corr.resize(env().getGrid()->FullDimensions()[env().getNd()-1]);
-            result.projection[i_p].corr_Q.resize(env().getGrid()->FullDimensions()[env().getNd()-1]);
-            result.projection[i_p].corr_Sun.resize(env().getGrid()->FullDimensions()[env().getNd()-1]);
-            result.projection[i_p].corr_Tad.resize(env().getGrid()->FullDimensions()[env().getNd()-1]);
-
-            for (unsigned int j = 0; j < env().getNd()-1; ++j)
-            {
-                siteCoor[j] = result.projection[i_p].momentum[j];
-            }
-
-            for (unsigned int t = 0; t < result.projection[i_p].corr.size(); ++t)
+            proj.corr.resize(nt);
+            proj.corr_0.resize(nt);
+            proj.corr_Q.resize(nt);
+            proj.corr_Sun.resize(nt);
+            proj.corr_Tad.resize(nt);
+            for (unsigned int t = 0; t < nt; ++t)
             {
-                siteCoor[env().getNd()-1] = t;
-                peekSite(site, prop, siteCoor);
-                result.projection[i_p].corr[t]=TensorRemove(site);
-                peekSite(site, buf, siteCoor);
-                result.projection[i_p].corr_0[t]=TensorRemove(site);
-                peekSite(site, propQ, siteCoor);
-                result.projection[i_p].corr_Q[t]=TensorRemove(site);
-                peekSite(site, propSun, siteCoor);
-                result.projection[i_p].corr_Sun[t]=TensorRemove(site);
-                peekSite(site, propTad, siteCoor);
-                result.projection[i_p].corr_Tad[t]=TensorRemove(site);
+                proj.corr[t]     = TensorRemove(site[(0*nMom + i_p)*nt + t]);
+                proj.corr_0[t]   = TensorRemove(site[(1*nMom + i_p)*nt + t]);
+                proj.corr_Q[t]   = TensorRemove(site[(2*nMom + i_p)*nt + t]);
+                proj.corr_Sun[t] = TensorRemove(site[(3*nMom + i_p)*nt + t]);
+                proj.corr_Tad[t] = TensorRemove(site[(4*nMom + i_p)*nt + t]);
             }
         }
         saveResult(par().output, "prop", result);
     }
 
-    std::vector<int> mask(env().getNd(),1);
-    mask[env().getNd()-1] = 0;
-    fft.FFT_dim_mask(prop, prop, mask, FFT::backward);
-    fft.FFT_dim_mask(propQ, propQ, mask, FFT::backward);
-    fft.FFT_dim_mask(propSun, propSun, mask, FFT::backward);
-    fft.FFT_dim_mask(propTad, propTad, mask, FFT::backward);
+    spaceFft(std::vector<ScalarField *>{&prop, &propQ, &propSun, &propTad},
+             std::vector<const ScalarField *>{&prop, &propQ, &propSun, &propTad},
+             FFT::backward, fftPacked, fftPackedFt);
 }
 
 void TChargedProp::makeCaches(void)
@@ -199,7 +203,8 @@ void TChargedProp::makeCaches(void)
     auto &freeMomProp = envGet(ScalarField, freeMomPropName_);
     auto &GFSrc       = envGet(ScalarField, GFSrcName_);
 	auto &prop0		  = envGet(ScalarField, prop0Name_);
-    auto &fft         = envGet(FFT, fftName_);
+    auto &fft         = env().getFft().getTransform(env().getGrid(),
+                                           std::vector<int>(env().getNd(), 1));
 
     if (!freeMomPropDone_)
     {
@@ -212,14 +217,14 @@ void TChargedProp::makeCaches(void)
         auto &source = envGet(ScalarField, par().source);
         
         LOG(Message) << "Caching G*F*src..." << std::endl;
-        fft.FFT_all_dim(GFSrc, source, FFT::forward);
+        fft(GFSrc, source, FFT::forward);
         GFSrc = freeMomProp*GFSrc;
     }
 	if (!prop0Done_)
 	{
 		LOG(Message) << "Caching position-space free scalar propagator..."
                      << std::endl;
-		fft.FFT_all_dim(prop0, GFSrc, FFT::backward);
+		fft(prop0, GFSrc, FFT::backward);
 	}
     if (!phasesDone_)
     {
@@ -247,7 +252,7 @@ void TChargedProp::makeCaches(void)
     }
 }
 
-void TChargedProp::momD1(ScalarField &s, FFT &fft)
+void TChargedProp::momD1(ScalarField &s, FftService::Transform &fft)
 {
     auto        &A = envGet(EmField, par().emField);
     Complex     ci(0.0,1.0);
@@ -261,24 +266,24 @@ void TChargedProp::momD1(ScalarField &s, FFT &fft)
     {
         Amu = peekLorentz(A, mu);
         buf = (*phase_[mu])*s;
-        fft.FFT_all_dim(buf, buf, FFT::backward);
+        fft(buf, buf, FFT::backward);
         buf = Amu*buf;
-        fft.FFT_all_dim(buf, buf, FFT::forward);
+        fft(buf, buf, FFT::forward);
         result = result - ci*buf;
     }
-    fft.FFT_all_dim(s, s, FFT::backward);
+    fft(s, s, FFT::backward);
     for (unsigned int mu = 0; mu < env().getNd(); ++mu)
     {
         Amu = peekLorentz(A, mu);
         buf = Amu*s;
-        fft.FFT_all_dim(buf, buf, FFT::forward);
+        fft(buf, buf, FFT::forward);
         result = result + ci*adj(*phase_[mu])*buf;
     }
 
     s = result;
 }
 
-void TChargedProp::momD2(ScalarField &s, FFT &fft)
+void TChargedProp::momD2(ScalarField &s, FftService::Transform &fft)
 {
     auto &A = envGet(EmField, par().emField);
 
@@ -291,17 +296,17 @@ void TChargedProp::momD2(ScalarField &s, FFT &fft)
     {
         Amu = peekLorentz(A, mu);
         buf = (*phase_[mu])*s;
-        fft.FFT_all_dim(buf, buf, FFT::backward);
+        fft(buf, buf, FFT::backward);
         buf = Amu*Amu*buf;
-        fft.FFT_all_dim(buf, buf, FFT::forward);
+        fft(buf, buf, FFT::forward);
         result = result + .5*buf;
     }
-    fft.FFT_all_dim(s, s, FFT::backward);
+    fft(s, s, FFT::backward);
     for (unsigned int mu = 0; mu < env().getNd(); ++mu)
     {
         Amu = peekLorentz(A, mu);        
         buf = Amu*Amu*s;
-        fft.FFT_all_dim(buf, buf, FFT::forward);
+        fft(buf, buf, FFT::forward);
         result = result + .5*adj(*phase_[mu])*buf;
     }
 
@@ -56,6 +56,7 @@ public:
     BASIC_TYPE_ALIASES(SIMPL,);
     typedef PhotonR::GaugeField     EmField;
     typedef PhotonR::GaugeLinkField EmComp;
+    typedef FftService::PackedField<ScalarField> FftPackedField;
     class Result: Serializable
     {
     public:
@@ -91,13 +92,13 @@ protected:
     virtual void execute(void);
 private:
     void makeCaches(void);
-    void momD1(ScalarField &s, FFT &fft);
-    void momD2(ScalarField &s, FFT &fft);
+    void momD1(ScalarField &s, FftService::Transform &fft);
+    void momD2(ScalarField &s, FftService::Transform &fft);
 private:
     bool                       freeMomPropDone_, GFSrcDone_, prop0Done_,
                                phasesDone_;
     std::string                freeMomPropName_, GFSrcName_, prop0Name_,
-                               propQName_, propSunName_, propTadName_, fftName_;
+                               propQName_, propSunName_, propTadName_;
     std::vector<std::string>   phaseName_;
     std::vector<ScalarField *> phase_;
 };
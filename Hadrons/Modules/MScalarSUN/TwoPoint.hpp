@@ -65,6 +65,7 @@ public:
     typedef typename SImpl::Field         Field;
     typedef typename SImpl::ComplexField  ComplexField;
     typedef          std::vector<Complex> SlicedOp;
+    typedef FftService::PackedField<ComplexField> FftPackedField;
 public:
     // constructor
     TTwoPoint(const std::string name);
@@ -128,7 +129,8 @@ std::vector<std::string> TTwoPoint<SImpl>::getOutput(void)
 template <typename SImpl>
 void TTwoPoint<SImpl>::setup(void)
 {
-    const unsigned int nd = env().getDim().size();
+    const unsigned int    nd = env().getDim().size();
+    std::set<std::string> ops;
 
     mom_.resize(par().mom.size());
     for (unsigned int i = 0; i < mom_.size(); ++i)
@@ -144,7 +146,15 @@ void TTwoPoint<SImpl>::setup(void)
             mom_[i][j] = (mom_[i][j] + env().getDim(j)) % env().getDim(j);
         }
     }
-    envTmpLat(ComplexField, "ftBuf");
+    for (auto &p: par().op)
+    {
+        ops.insert(p.first);
+        ops.insert(p.second);
+    }
+    envTmp(std::vector<ComplexField>, "ftBuf", 1, ops.size(),
+           envGetGrid(ComplexField));
+    envTmpLat(FftPackedField, "fftPacked");
+    envTmpLat(FftPackedField, "fftPackedFt");
 }
 
 // execution ///////////////////////////////////////////////////////////////////
@@ -162,15 +172,17 @@ void TTwoPoint<SImpl>::execute(void)
     const unsigned int                           nop     = par().op.size();
     const unsigned int                           nmom    = mom_.size();
     double                                       partVol = 1.;
-    std::vector<int>                             dMask(nd, 1);
     std::set<std::string>                        ops;
     std::vector<TwoPointResult>                  result;
     std::map<std::string, std::vector<SlicedOp>> slicedOp;
-    FFT                                          fft(envGetGrid(Field));
-    TComplex                                     buf;
-
-    envGetTmp(ComplexField, ftBuf);
-    dMask[nd - 1] = 0;
+    std::vector<const ComplexField *>            opPt, ftPt;
+    std::vector<ComplexField *>                  outPt;
+    std::vector<TComplex>                        buf;
+    auto &fft = env().getFft().getSpatialTransform(envGetGrid(ComplexField));
+
+    envGetTmp(std::vector<ComplexField>, ftBuf);
+    envGetTmp(FftPackedField, fftPacked);
+    envGetTmp(FftPackedField, fftPackedFt);
     for (unsigned int mu = 0; mu < nd - 1; ++mu)
     {
         partVol *= env().getDim()[mu];
@@ -182,22 +194,24 @@ void TTwoPoint<SImpl>::execute(void)
     }
     for (auto &o: ops)
     {
-        auto &op = envGet(ComplexField, o);
+        opPt.push_back(&envGet(ComplexField, o));
+        outPt.push_back(&ftBuf[outPt.size()]);
+        ftPt.push_back(outPt.back());
+    }
+    LOG(Message) << "FFT of " << ops.size() << " operator(s)" << std::endl;
+    fft(outPt, opPt, FFT::forward, fftPacked, fftPackedFt);
+    FftService::gatherMomenta(buf, ftPt, mom_);
+    for (auto &o: ops)
+    {
+        const unsigned int i = slicedOp.size();
 
         slicedOp[o].resize(nmom);
-        LOG(Message) << "Operator '" << o << "' FFT" << std::endl;
-        fft.FFT_dim_mask(ftBuf, op, dMask, FFT::forward);
         for (unsigned int m = 0; m < nmom; ++m)
         {
-            auto qt = mom_[m];
-
-            qt.resize(nd);
             slicedOp[o][m].resize(nt);
             for (unsigned int t = 0; t < nt; ++t)
             {
-                qt[nd - 1] = t;
-                peekSite(buf, ftBuf, qt);
-                slicedOp[o][m][t] = TensorRemove(buf);
+                slicedOp[o][m][t] = TensorRemove(buf[(i*nmom + m)*nt + t]);
             }
         }
     }
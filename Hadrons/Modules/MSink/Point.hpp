@@ -34,6 +34,7 @@
 #include <Hadrons/Global.hpp>
 #include <Hadrons/Module.hpp>
 #include <Hadrons/ModuleFactory.hpp>
+#include <Hadrons/MomentumProjector.hpp>
 
 BEGIN_HADRONS_NAMESPACE
 
@@ -50,7 +51,7 @@ public:
 };
 
 template <typename Field>
-class TPoint: public Module<PointPar>
+class TPoint: public Module<PointPar>, public MomentumProjectorSink
 {
 public:
     typedef Field PropagatorField;
@@ -65,14 +66,15 @@ public:
     // dependency relation
     virtual std::vector<std::string> getInput(void);
     virtual std::vector<std::string> getOutput(void);
+    // momentum projector used by the sink function
+    virtual const MomentumProjector & getMomentumProjector(void) const;
 protected:
     // setup
     virtual void setup(void);
     // execution
     virtual void execute(void);
 private:
-    bool        hasPhase_{false}; 
-    std::string momphName_;
+    std::shared_ptr<MomentumProjector> proj_{nullptr};
 };
 
 typedef Lattice<iScalar<iMatrix<iScalar<vComplex>,Ns>>> SpinMatField;
@@ -88,7 +90,6 @@ MODULE_REGISTER_TMP(SMatPoint,   TPoint<SpinMatField>           , MSink);
 template <typename Field>
 TPoint<Field>::TPoint(const std::string name)
 : Module<PointPar>(name)
-, momphName_ (name + "_momph")
 {}
 
 // dependencies/products ///////////////////////////////////////////////////////
@@ -108,12 +109,30 @@ std::vector<std::string> TPoint<Field>::getOutput(void)
     return out;
 }
 
+// momentum projector //////////////////////////////////////////////////////////
+template <typename Field>
+const MomentumProjector & TPoint<Field>::getMomentumProjector(void) const
+{
+    if (!proj_)
+    {
+        HADRONS_ERROR(Definition, "momentum projector of sink '" + getName()
+                      + "' used before setup");
+    }
+
+    return *proj_;
+}
+
 // setup ///////////////////////////////////////////////////////////////////////
 template <typename Field>
 void TPoint<Field>::setup(void)
 {
-    envTmpLat(LatticeComplex, "coor");
-    envCacheLat(LatticeComplex, momphName_);
+    // phases are generated on the fly from the site coordinates
+    if (!proj_)
+    {
+        std::vector<std::vector<Real>> mom = {strToVec<Real>(par().mom)};
+
+        proj_.reset(new MomentumProjector(env().getGrid(), mom, Tp));
+    }
     envCreate(SinkFn, getName(), 1, nullptr);
 }
 
@@ -124,32 +143,12 @@ void TPoint<Field>::execute(void)
     LOG(Message) << "Setting up point sink function for momentum ["
                  << par().mom << "]" << std::endl;
 
-    auto &ph = envGet(LatticeComplex, momphName_);
-    
-    if (!hasPhase_)
-    {
-        Complex           i(0.0,1.0);
-        std::vector<Real> p;
-
-        envGetTmp(LatticeComplex, coor);
-        p  = strToVec<Real>(par().mom);
-        ph = Zero();
-        for(unsigned int mu = 0; mu < p.size(); mu++)
-        {
-            LatticeCoordinate(coor, mu);
-            ph = ph + (p[mu]/env().getDim(mu))*coor;
-        }
-        ph = exp((Real)(2*M_PI)*i*ph);
-        hasPhase_ = true;
-    }
     auto sink = [this](const PropagatorField &field)
     {
         SlicedPropagator res;
-        auto             &ph = envGet(LatticeComplex, momphName_);
-        PropagatorField  tmp = ph*field;
-        
-        sliceSum(tmp, res, Tp);
-        
+
+        proj_->project(res, field);
+
         return res;
     };
     envGet(SinkFn, getName()) = sink;
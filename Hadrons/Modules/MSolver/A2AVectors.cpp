@@ -34,3 +34,8 @@ template class Grid::Hadrons::MSolver::TA2AVectors<ZFIMPL, BaseFermionEigenPack<
 template class Grid::Hadrons::MSolver::TStagA2AVectors<STAGIMPL, BaseFermionEigenPack<STAGIMPL>>;
 template class Grid::Hadrons::MSolver::TStagNoEvalA2AVectors<STAGIMPL, BaseFermionEigenPack<STAGIMPL>>;
 template class Grid::Hadrons::MSolver::TStagSparseA2AVectors<STAGIMPL, BaseFermionEigenPack<STAGIMPL>>;
+#ifdef GRID_DEFAULT_PRECISION_DOUBLE
+template class Grid::Hadrons::MSolver::TA2AVectors<FIMPL, BaseFermionEigenPack<FIMPLF>>;
+template class Grid::Hadrons::MSolver::TStagA2AVectors<STAGIMPL, BaseFermionEigenPack<STAGIMPLF>>;
+template class Grid::Hadrons::MSolver::TStagSparseA2AVectors<STAGIMPL, BaseFermionEigenPack<STAGIMPLF>>;
+#endif
@@ -36,6 +36,7 @@
 #include <Hadrons/EigenPack.hpp>
 #include <Hadrons/A2AVectors.hpp>
 #include <Hadrons/DilutedNoise.hpp>
+#include <Hadrons/SparseLattice.hpp>
 
 BEGIN_HADRONS_NAMESPACE
 
@@ -58,7 +59,8 @@ public:
                                     int, tinc,
                                     bool, doubleMemory,
                                     double, mass,
-                                    bool,        multiFile);
+                                    bool,        multiFile,
+                                    bool,        logNorms);
 };
 
 template <typename FImpl, typename Pack>
@@ -89,6 +91,10 @@ MODULE_REGISTER_TMP(A2AVectors,
     ARG(TA2AVectors<FIMPL, BaseFermionEigenPack<FIMPL>>), MSolver);
 MODULE_REGISTER_TMP(ZA2AVectors, 
     ARG(TA2AVectors<ZFIMPL, BaseFermionEigenPack<ZFIMPL>>), MSolver);
+#ifdef GRID_DEFAULT_PRECISION_DOUBLE
+MODULE_REGISTER_TMP(MixedPrecisionA2AVectors, 
+    ARG(TA2AVectors<FIMPL, BaseFermionEigenPack<FIMPLF>>), MSolver);
+#endif
 
 /******************************************************************************
  *                       TA2AVectors implementation                           *
@@ -140,6 +146,10 @@ void TA2AVectors<FImpl, Pack>::setup(void)
     {
         auto &epack = envGet(Pack, par().eigenPack);
         Nl_ = epack.evec.size();
+        if (typeHash<FermionField>() != typeHash<typename Pack::Field>())
+        {
+            envTmp(FermionField, "evecBuf", Ls, action.FermionRedBlackGrid());
+        }
     }
     envCreate(std::vector<FermionField>, getName() + "_v", 1, 
               Nl_ + noise.fermSize(), envGetGrid(FermionField));
@@ -181,34 +191,30 @@ void TA2AVectors<FImpl, Pack>::execute(void)
                      << " noise vectors)" << std::endl;
     }
     // Low modes
+    FermionField *evecBufPt = nullptr;
+
+    if ((Nl_ > 0) and (typeHash<FermionField>() != typeHash<typename Pack::Field>()))
+    {
+        envGetTmp(FermionField, evecBuf);
+        evecBufPt = &evecBuf;
+    }
     for (unsigned int il = 0; il < Nl_; il++)
     {
         auto &epack  = envGet(Pack, par().eigenPack);
+        auto &evec   = promoteEvec(epack.evec, il, evecBufPt);
 
-        startTimer("V low mode");
-        LOG(Message) << "V vector i = " << il << " (low mode)" << std::endl;
-        if (Ls == 1)
-        {
-            a2a.makeLowModeV(v[il], epack.evec[il], epack.eval[il]);
-        }
-        else
-        {
-            envGetTmp(FermionField, f5);
-            a2a.makeLowModeV5D(v[il], f5, epack.evec[il], epack.eval[il]);
-        }
-        stopTimer("V low mode");
-        startTimer("W low mode");
-        LOG(Message) << "W vector i = " << il << " (low mode)" << std::endl;
+        startTimer("V & W low mode");
+        LOG(Message) << "V & W vectors i = " << il << " (low mode)" << std::endl;
         if (Ls == 1)
         {
-            a2a.makeLowModeW(w[il], epack.evec[il], epack.eval[il]);
+            a2a.makeLowModeVW(v[il], w[il], evec, epack.eval[il]);
         }
         else
         {
             envGetTmp(FermionField, f5);
-            a2a.makeLowModeW5D(w[il], f5, epack.evec[il], epack.eval[il]);
+            a2a.makeLowModeVW5D(v[il], w[il], f5, evec, epack.eval[il]);
         }
-        stopTimer("W low mode");
+        stopTimer("V & W low mode");
     }
 
     // High modes
@@ -244,16 +250,17 @@ void TA2AVectors<FImpl, Pack>::execute(void)
         stopTimer("W high mode");
     }
 
-    // Print out v mode norms
-    for (unsigned int il = 0; il < Nl_; il++)
+    // Print out low mode norms (one global reduction per vector)
+    if (par().logNorms)
+    {
+        for (unsigned int il = 0; il < Nl_; il++)
         {
-          LOG(Message) << "V vector i = " << il << " (low mode)" << " | norm " << norm2(v[il]) << std::endl;
+            LOG(Message) << "V vector i = " << il << " (low mode)" << " | norm " << norm2(v[il]) << std::endl;
         }
-    
-    // Print out w mode norms
-    for (unsigned int il = 0; il < Nl_; il++)
+        for (unsigned int il = 0; il < Nl_; il++)
         {
-          LOG(Message) << "W vector i = " << il << " (low mode)" << " | norm " << norm2(w[il]) << std::endl;
+            LOG(Message) << "W vector i = " << il << " (low mode)" << " | norm " << norm2(w[il]) << std::endl;
+        }
     }
 
     // I/O if necessary
@@ -295,6 +302,11 @@ private:
 MODULE_REGISTER_TMP(StagA2AVectors,
                     ARG(TStagA2AVectors<STAGIMPL, BaseFermionEigenPack<STAGIMPL>>),
                     MSolver);
+#ifdef GRID_DEFAULT_PRECISION_DOUBLE
+MODULE_REGISTER_TMP(StagMixedPrecisionA2AVectors,
+                    ARG(TStagA2AVectors<STAGIMPL, BaseFermionEigenPack<STAGIMPLF>>),
+                    MSolver);
+#endif
 
 /******************************************************************************
  *                       TStagA2AVectors implementation                           *
@@ -347,6 +359,10 @@ void TStagA2AVectors<FImpl, Pack>::setup(void)
     {
         auto &epack = envGet(Pack, par().eigenPack);
         Nl_ = epack.evec.size();
+        if (typeHash<FermionField>() != typeHash<typename Pack::Field>())
+        {
+            envTmp(FermionField, "evecBuf", Ls, action.FermionRedBlackGrid());
+        }
     }
     envCreate(std::vector<FermionField>, getName() + "_v", 1,
               2*Nl_ + noise.fermSize(), envGetGrid(FermionField));
@@ -389,41 +405,49 @@ void TStagA2AVectors<FImpl, Pack>::execute(void)
     }
     // Low modes
     auto &epack  = envGet(Pack, par().eigenPack);
+    FermionField *evecBufPt = nullptr;
+
+    if ((Nl_ > 0) and (typeHash<FermionField>() != typeHash<typename Pack::Field>()))
+    {
+        envGetTmp(FermionField, evecBuf);
+        evecBufPt = &evecBuf;
+    }
     for (unsigned int il = 0; il < Nl_; il++)
     {
         // eval of unpreconditioned Dirac op
         std::complex<double> eval(mass,sqrt(epack.eval[il]-mass*mass));
+        auto &evec = promoteEvec(epack.evec, il, evecBufPt);
         
         startTimer("V low mode");
         LOG(Message) << "V vector i = " << 2*il << ", " << 2*il+1 << " (low modes)" << std::endl;
         if (Ls == 1)
         {
-            a2a.makeLowModeV(v[2*il], epack.evec[il], eval);
+            a2a.makeLowModeV(v[2*il], evec, eval);
             // construct -lambda evec
-            a2a.makeLowModeV(v[2*il+1], epack.evec[il], eval, 1);
+            a2a.makeLowModeV(v[2*il+1], evec, eval, 1);
         }
         else
         {
             envGetTmp(FermionField, f5);
-            a2a.makeLowModeV5D(v[2*il], f5, epack.evec[il], eval);
+            a2a.makeLowModeV5D(v[2*il], f5, evec, eval);
             // construct -lambda evec
-            a2a.makeLowModeV5D(v[2*il+1], f5, epack.evec[il], eval, 1);
+            a2a.makeLowModeV5D(v[2*il+1], f5, evec, eval, 1);
         }
         stopTimer("V low mode");
         startTimer("W low mode");
         LOG(Message) << "W vector i = " << 2*il << ", " << 2*il+1 << " (low modes)" << std::endl;
         if (Ls == 1)
         {
-            a2a.makeLowModeW(w[2*il], epack.evec[il], eval);
+            a2a.makeLowModeW(w[2*il], evec, eval);
             // construct -lambda evec
-            a2a.makeLowModeW(w[2*il+1], epack.evec[il], eval, 1);
+            a2a.makeLowModeW(w[2*il+1], evec, eval, 1);
         }
         else
         {
             envGetTmp(FermionField, f5);
-            a2a.makeLowModeW5D(w[2*il], f5, epack.evec[il], eval);
+            a2a.makeLowModeW5D(w[2*il], f5, evec, eval);
             // construct -lambda evec
-            a2a.makeLowModeW5D(w[2*il+1], f5, epack.evec[il], eval, 1);
+            a2a.makeLowModeW5D(w[2*il+1], f5, evec, eval, 1);
         }
         stopTimer("W low mode");
     }
@@ -689,6 +713,10 @@ private:
 
 MODULE_REGISTER_TMP(StagSparseA2AVectors,
                     ARG(TStagSparseA2AVectors<STAGIMPL, BaseFermionEigenPack<STAGIMPL>>),MSolver);
+#ifdef GRID_DEFAULT_PRECISION_DOUBLE
+MODULE_REGISTER_TMP(StagSparseMixedPrecisionA2AVectors,
+                    ARG(TStagSparseA2AVectors<STAGIMPL, BaseFermionEigenPack<STAGIMPLF>>),MSolver);
+#endif
 
 /******************************************************************************
  *                       TStagSparseA2AVectors implementation                           *
@@ -731,6 +759,10 @@ void TStagSparseA2AVectors<FImpl, Pack>::setup(void)
     auto &epack = envGet(Pack, par().eigenPack);
     Nl_ = epack.evec.size();
     envTmp(A2A, "a2a", 1, action, solver);
+    if (typeHash<FermionField>() != typeHash<typename Pack::Field>())
+    {
+        envTmp(FermionField, "evecBuf", 1, action.FermionRedBlackGrid());
+    }
     
     // Sparse Grid
     std::vector<int> blocksize(4);
@@ -775,16 +807,8 @@ void TStagSparseA2AVectors<FImpl, Pack>::execute(void)
     
     LOG(Message) << "Computing all-to-all vectors using eigenpack " << par().eigenPack << " with " << 2*Nl_ << " low modes " << std::endl;
 
-    // Staggered Phases. Do spatial gamma only
-    Lattice<iScalar<vInteger> > x(U.Grid()); LatticeCoordinate(x,0);
-    Lattice<iScalar<vInteger> > y(U.Grid()); LatticeCoordinate(y,1);
-    Lattice<iScalar<vInteger> > lin_z(U.Grid()); lin_z=x+y;
-        
-    ComplexField phases(U.Grid());
-    int shift;
     FermionField temp(U.Grid());
     FermionField temp2(U.Grid());
-    //SparseFermionField temp3(&sparseGrid);
     
     //std::random_device rd;  // a seed source for the random number engine
     //std::mt19937 gen(rd()); // mersenne_twister_engine seeded with rd()
@@ -810,16 +834,51 @@ void TStagSparseA2AVectors<FImpl, Pack>::execute(void)
     CartesianCommunicator::BroadcastWorld(0,(void *)&yshift[0],sizeof(uint32_t)*yshift.size());
     CartesianCommunicator::BroadcastWorld(0,(void *)&zshift[0],sizeof(uint32_t)*zshift.size());
     
+    // map to the sparse sites, built once for all vectors
+    std::vector<int>                        blocksize = {par().inc, par().inc,
+                                                         par().inc, par().tinc};
+    std::vector<std::vector<unsigned int>>  shift(nt);
+    GridBase                                *sparseGrid = v[0].Grid();
+
+    for(int t=0;t<nt;t++){
+        shift[t] = {xshift[t], yshift[t], zshift[t]};
+    }
+    SparseLatticeMap sparse(U.Grid(), sparseGrid, blocksize, shift);
+
+    // links with staggered phases (spatial gamma only), only kept on the
+    // sparse sites
+    std::vector<LatticeColourMatrix> sparseU(3, LatticeColourMatrix(sparseGrid));
+    {
+        Lattice<iScalar<vInteger> > x(U.Grid()); LatticeCoordinate(x,0);
+        Lattice<iScalar<vInteger> > y(U.Grid()); LatticeCoordinate(y,1);
+        Lattice<iScalar<vInteger> > lin_z(U.Grid()); lin_z=x+y;
+        ComplexField                phases(U.Grid());
+        LatticeColourMatrix         Umu(U.Grid());
+
+        for (int mu=0;mu<3;mu++){
+            phases=1.0;
+            if(mu==1){
+                phases = where( mod(x    ,2)==(Integer)0, phases,-phases);
+            } else if(mu==2){
+                phases = where( mod(lin_z,2)==(Integer)0, phases,-phases);
+            }
+            Umu = PeekIndex<LorentzIndex>(U,mu);
+            Umu *= phases;
+            sparse.gather(sparseU[mu], Umu);
+        }
+    }
+    
     //save for later
     std::vector<complex<double>> evalM(2*Nl_);
     
-    // global to local coord shift
-    int tloc2glbshift;
-    tloc2glbshift=U.Grid()->_lstart[3];
-    int locx=U.Grid()->_ldimensions[0];
-    int locy=U.Grid()->_ldimensions[1];
-    int locz=U.Grid()->_ldimensions[2];
-    int loct=U.Grid()->_ldimensions[3];
+    std::vector<std::vector<SparseFermionField> *> w = {&w0, &w1, &w2};
+    SparseFermionField sparseBuf(sparseGrid);
+    FermionField *evecBufPt = nullptr;
+    if (typeHash<FermionField>() != typeHash<typename Pack::Field>())
+    {
+        envGetTmp(FermionField, evecBuf);
+        evecBufPt = &evecBuf;
+    }
     for (unsigned int il = 0; il < 2*Nl_; il++)
     {
         // eval of unpreconditioned Dirac op
@@ -828,64 +887,23 @@ void TStagSparseA2AVectors<FImpl, Pack>::execute(void)
         startTimer("W low mode");
         LOG(Message) << "W vector i = " << il << " (low modes)" << std::endl;
         // don't divide by lambda. Do it in contraction since it is complex
-        a2a.makeLowModeW(temp, epack.evec[il/2], eval, il%2);
+        a2a.makeLowModeW(temp, promoteEvec(epack.evec, il/2, evecBufPt), eval, il%2);
         
         stopTimer("W low mode");
         il%2 ? eval=conjugate(eval) : eval ;
         evalM[il]=eval;
         
+        // Sparsen
+        startTimer("sparsen");
+        sparse.gather(v[il], temp);
         for (int mu=0;mu<3;mu++){
-            
-            phases=1.0;
-            if(mu==1){
-                phases = where( mod(x    ,2)==(Integer)0, phases,-phases);
-            } else if(mu==2){
-                phases = where( mod(lin_z,2)==(Integer)0, phases,-phases);
-            }
-            LatticeColourMatrix Umu(U.Grid());
-            Umu = PeekIndex<LorentzIndex>(U,mu);
-            Umu *= phases;
-        
-            // v vec is shifted and * link for conserved current
-            temp2 = Umu*Cshift(temp, mu, 1);
-            
-            // Sparsen
-            //thread_for_collapse(4,t,loct,{
-            thread_for(t,loct,{
-
-                int tglb=t+tloc2glbshift;
-                Coordinate site(Nd);
-                Coordinate sparseSite(Nd);
-                ColourVector vec;
-                for(int z=zshift[tglb];z<locz;z+=par().inc){
-                    for(int y=yshift[tglb];y<locy;y+=par().inc){
-                        for(int x=xshift[tglb];x<locx;x+=par().inc){
-                            
-                            site[0]=x;
-                            site[1]=y;
-                            site[2]=z;
-                            site[3]=t;
-                            sparseSite[3]=t;
-                            for(int i=0;i<Nd-1;i++)
-                                sparseSite[i]=site[i]/par().inc;
-                            
-                            if(mu==0){// do v once
-                                peekLocalSite(vec,temp,site);
-                                pokeLocalSite(vec,v[il],sparseSite);
-                                peekLocalSite(vec,temp2,site);
-                                pokeLocalSite(vec,w0[il],sparseSite);
-                            }else if(mu==1){
-                                peekLocalSite(vec,temp2,site);
-                                pokeLocalSite(vec,w1[il],sparseSite);
-                            }else if(mu==2){
-                                peekLocalSite(vec,temp2,site);
-                                pokeLocalSite(vec,w2[il],sparseSite);
-                            }
-                        }
-                    }
-                }
-            });
+            // w vec is shifted and * link for conserved current, the link
+            // multiplication is only done on the sparse sites
+            temp2 = Cshift(temp, mu, 1);
+            sparse.gather(sparseBuf, temp2);
+            (*w[mu])[il] = sparseU[mu]*sparseBuf;
         }// end mu
+        stopTimer("sparsen");
     }// end evecs
     
     std::string dir = dirname(par().output);
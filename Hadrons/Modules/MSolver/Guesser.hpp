@@ -32,14 +32,55 @@
 BEGIN_HADRONS_NAMESPACE
 BEGIN_MODULE_NAMESPACE(MSolver)
 
-template <typename FImpl, int nBasis>
+// deflated guess from an eigenpack stored at lower precision, each eigenvector
+// is promoted to the working precision when it is used
+template <typename Field, typename FieldLow>
+class MixedPrecisionDeflatedGuesser: public LinearFunction<Field>
+{
+public:
+    using LinearFunction<Field>::operator();
+    MixedPrecisionDeflatedGuesser(const std::vector<FieldLow> &evec,
+                                  const std::vector<RealD> &eval)
+    : evec_(evec), eval_(eval)
+    {}
+    virtual ~MixedPrecisionDeflatedGuesser(void) = default;
+
+    virtual void operator()(const Field &src, Field &guess)
+    {
+        // the promotion buffer is allocated once and reused by later calls
+        if (!buf_ or (buf_->Grid() != src.Grid()))
+        {
+            buf_.reset(new Field(src.Grid()));
+        }
+        assert(evec_.size() == eval_.size());
+        guess = Zero();
+        guess.Checkerboard() = src.Checkerboard();
+        for (unsigned int i = 0; i < evec_.size(); ++i)
+        {
+            const Field &tmp = promoteEvec(evec_, i, buf_.get());
+
+            axpy(guess, TensorRemove(innerProduct(tmp, src))/eval_[i], tmp, guess);
+        }
+        guess.Checkerboard() = src.Checkerboard();
+    }
+private:
+    const std::vector<FieldLow> &evec_;
+    const std::vector<RealD>    &eval_;
+    std::unique_ptr<Field>      buf_;
+};
+
+template <typename FImpl, int nBasis, typename FImplLow = FImpl>
 std::shared_ptr<LinearFunction<typename FImpl::FermionField>> 
 makeGuesser(const std::string epackName)
 {
     typedef typename FImpl::FermionField                  FermionField;
+    typedef typename FImplLow::FermionField               FermionFieldLow;
     typedef BaseFermionEigenPack<FImpl>                   EPack;
+    typedef BaseFermionEigenPack<FImplLow>                EPackLow;
     typedef CoarseFermionEigenPack<FImpl, nBasis>         CoarseEPack;
     typedef DeflatedGuesser<FermionField>                 FineGuesser;
+    typedef MixedPrecisionDeflatedGuesser<
+        FermionField, FermionFieldLow>                    LowGuesser;
     typedef LocalCoherenceDeflatedGuesser<
         FermionField, typename CoarseEPack::CoarseField>  CoarseGuesser;
 
@@ -65,6 +106,19 @@ makeGuesser(const std::string epackName)
         }
         catch (Exceptions::ObjectType &e)
         {
+            if ((typeHash<FImpl>() != typeHash<FImplLow>())
+                and envHasType(EPackLow, epackName))
+            {
+                auto &epack = envGet(EPackLow, epackName);
+
+                LOG(Message) << "using low-mode deflation with low-precision eigenpack '"
+                             << epackName << "' (" 
+                             << epack.evec.size() << " modes)" << std::endl;
+                guesserPt.reset(new LowGuesser(epack.evec, epack.eval));
+
+                return guesserPt;
+            }
+
             auto &epack = envGet(EPack, epackName);
 
             LOG(Message) << "using low-mode deflation with eigenpack '"
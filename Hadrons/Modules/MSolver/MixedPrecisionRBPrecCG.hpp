@@ -50,7 +50,8 @@ public:
                                     unsigned int, maxInnerIteration,
                                     unsigned int, maxOuterIteration,
                                     double      , residual,
-                                    std::string , eigenPack);
+                                    std::string , eigenPack,
+                                    bool        , outerDeflation);
 };
 
 template <typename FImplInner, typename FImplOuter, int nBasis>
@@ -168,7 +169,14 @@ void TMixedPrecisionRBPrecCG<FImplInner, FImplOuter, nBasis>
     }
     catch (Exceptions::ObjectType &e)
     {
+        // single precision eigenpack: deflate the inner solves directly and,
+        // if requested, the outer solve by promoting the eigenvectors on the
+        // fly (off by default, the outer solve then has no guess)
         guesserPt32 = makeGuesser<FImplInner, nBasis>(par().eigenPack);
+        if (par().outerDeflation)
+        {
+            guesserPt64 = makeGuesser<FImplOuter, nBasis, FImplInner>(par().eigenPack);
+        }
     }
 
     auto makeSolver = [&imat, &omat, guesserPt32, guesserPt64, Ls, this](bool subGuess)
@@ -0,0 +1,323 @@
+/*
+ * MomentumProjector.hpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+#ifndef Hadrons_MomentumProjector_hpp_
+#define Hadrons_MomentumProjector_hpp_
+
+#include <Hadrons/Global.hpp>
+
+BEGIN_HADRONS_NAMESPACE
+
+/******************************************************************************
+ *                  Batched multi-momentum slice reduction                    *
+ ******************************************************************************/
+// Computes
+//   res[(i*nMom + m)*nt + t] = sum_{x, x_orthog = t} exp(2 i pi p_m.x/L) op_i(x)
+// for a batch of fields op_i and a list of momenta p_m in a single sweep over
+// the local volume, followed by a single global sum. The phases are not
+// stored as fields: for each momentum and direction the SIMD vector of phases
+// of every reduced coordinate is tabulated, and the phase of a site is the
+// product of these over the directions. Momentum components are given in
+// units of 2 pi/L for the directions other than orthogDim, in order.
+// The op_i can also be computed site by site by a kernel, in which case they
+// are never stored as fields. The kernel is called concurrently by several
+// threads, on distinct sites.
+class MomentumProjector
+{
+public:
+    typedef std::vector<vComplex, alignedAllocator<vComplex>> PhaseTable;
+public:
+    // constructor
+    MomentumProjector(GridBase *grid, const std::vector<std::vector<Real>> &mom,
+                      const unsigned int orthogDim);
+    virtual ~MomentumProjector(void) = default;
+    // access
+    unsigned int momentumCount(void) const;
+    // projection of a batch of fields
+    template <typename vobj>
+    void project(std::vector<typename vobj::scalar_object> &res,
+                 const std::vector<const Lattice<vobj> *> &op) const;
+    template <typename vobj>
+    void project(std::vector<typename vobj::scalar_object> &res,
+                 const std::vector<Lattice<vobj>> &op) const;
+    template <typename vobj>
+    void project(std::vector<typename vobj::scalar_object> &res,
+                 const Lattice<vobj> &op) const;
+    // projection of nOp values computed on the fly, kernel(ss, val) must
+    // write op_i at the outer site ss in val[i] for all i < nOp
+    template <typename vobj, typename Kernel>
+    void projectSites(std::vector<typename vobj::scalar_object> &res,
+                      const unsigned int nOp, Kernel &&kernel) const;
+private:
+    vComplex sitePhase(const unsigned int m, const Coordinate &ocoor) const;
+private:
+    GridBase                      *grid_;
+    unsigned int                  orthogDim_, nMom_;
+    std::vector<std::vector<int>> offset_;
+    PhaseTable                    phase_;
+    std::vector<bool>             zeroMom_;
+};
+
+// interface for modules whose output is a momentum projection (e.g. point
+// sinks), consumers can then fuse the projection with their own site kernel
+// through projectSites instead of building fields for the sink function
+class MomentumProjectorSink
+{
+public:
+    virtual ~MomentumProjectorSink(void) = default;
+    virtual const MomentumProjector & getMomentumProjector(void) const = 0;
+};
+
+/******************************************************************************
+ *                   MomentumProjector implementation                         *
+ ******************************************************************************/
+inline MomentumProjector::MomentumProjector(GridBase *grid,
+                                            const std::vector<std::vector<Real>> &mom,
+                                            const unsigned int orthogDim)
+: grid_(grid), orthogDim_(orthogDim), nMom_(mom.size())
+{
+    typedef typename vComplex::scalar_type Scalar;
+
+    const int  nd    = grid_->_ndimension;
+    const int  Nsimd = grid_->Nsimd();
+    Coordinate icoor(nd);
+    int        size  = 0;
+
+    offset_.assign(nMom_, std::vector<int>(nd, -1));
+    zeroMom_.assign(nMom_, true);
+    for (unsigned int m = 0; m < nMom_; ++m)
+    {
+        if (mom[m].size() != nd - 1)
+        {
+            HADRONS_ERROR(Size, "momentum has " + std::to_string(mom[m].size())
+                          + " components instead of " + std::to_string(nd - 1));
+        }
+        for (int mu = 0, j = 0; mu < nd; ++mu)
+        {
+            if (mu != orthogDim_)
+            {
+                if (mom[m][j] != 0.)
+                {
+                    offset_[m][mu] = size;
+                    size          += grid_->_rdimensions[mu];
+                    zeroMom_[m]    = false;
+                }
+                j++;
+            }
+        }
+    }
+    phase_.resize(size);
+    for (unsigned int m = 0; m < nMom_; ++m)
+    for (int mu = 0, j = 0; mu < nd; ++mu)
+    {
+        if (mu == orthogDim_)
+        {
+            continue;
+        }
+        if (offset_[m][mu] >= 0)
+        {
+            const int  start = grid_->_processor_coor[mu]*grid_->_ldimensions[mu];
+            const Real p     = 2.*M_PI*mom[m][j]/grid_->_fdimensions[mu];
+
+            for (int o = 0; o < grid_->_rdimensions[mu]; ++o)
+            {
+                Scalar *lane = reinterpret_cast<Scalar *>(&phase_[offset_[m][mu] + o]);
+
+                for (int idx = 0; idx < Nsimd; idx++)
+                {
+                    grid_->iCoorFromIindex(icoor, idx);
+
+                    const int x = start + o + icoor[mu]*grid_->_rdimensions[mu];
+
+                    lane[idx] = Scalar(std::cos(p*x), std::sin(p*x));
+                }
+            }
+        }
+        j++;
+    }
+}
+
+inline unsigned int MomentumProjector::momentumCount(void) const
+{
+    return nMom_;
+}
+
+inline vComplex MomentumProjector::sitePhase(const unsigned int m,
+                                             const Coordinate &ocoor) const
+{
+    vComplex ph;
+
+    vone(ph);
+    for (int mu = 0; mu < ocoor.size(); ++mu)
+    {
+        if (offset_[m][mu] >= 0)
+        {
+            ph = ph*phase_[offset_[m][mu] + ocoor[mu]];
+        }
+    }
+
+    return ph;
+}
+
+template <typename vobj, typename Kernel>
+void MomentumProjector::projectSites(std::vector<typename vobj::scalar_object> &res,
+                                     const unsigned int nOp, Kernel &&kernel) const
+{
+    typedef typename vobj::scalar_object sobj;
+    typedef typename vobj::scalar_type   Scalar;
+
+    const int               nd{grid_->_ndimension};
+    const int               Nsimd{grid_->Nsimd()};
+    const int               od = orthogDim_;
+    const int               fd{grid_->_fdimensions[od]};
+    const int               ld{grid_->_ldimensions[od]};
+    const int               rd{grid_->_rdimensions[od]};
+    const int               ostride{grid_->_ostride[od]};
+    const int               tFirst{grid_->_processor_coor[od]*ld};
+    const int               osites{grid_->oSites()};
+    const int               nSum = nOp*nMom_;
+    const int               nthread{GridThread::GetThreads()};
+    std::vector<vobj, alignedAllocator<vobj>> lvSum(nthread*nSum*rd);
+    ExtractBuffer<sobj>     extracted(Nsimd);
+    Coordinate              icoor(nd);
+
+    // the threads share all the outer sites and accumulate per-thread partial
+    // sums, the outer slice of site ss is (ss/ostride) % rd
+    thread_for(thr, nthread,
+    {
+        int        mywork, myoff;
+        vobj       *sum = &lvSum[thr*nSum*rd];
+        Coordinate ocoor(nd);
+        std::vector<vobj, alignedAllocator<vobj>> val(nOp);
+
+        GridThread::GetWork(osites, thr, mywork, myoff);
+        for (int s = 0; s < nSum*rd; ++s)
+        {
+            sum[s] = Zero();
+        }
+        for (int ss = myoff; ss < myoff + mywork; ss++)
+        {
+            const int r{(ss/ostride) % rd};
+
+            kernel(ss, val.data());
+            grid_->oCoorFromOindex(ocoor, ss);
+            for (unsigned int m = 0; m < nMom_; ++m)
+            {
+                if (zeroMom_[m])
+                {
+                    for (int i = 0; i < nOp; ++i)
+                    {
+                        sum[(i*nMom_ + m)*rd + r] += val[i];
+                    }
+                }
+                else
+                {
+                    const vComplex ph = sitePhase(m, ocoor);
+
+                    for (int i = 0; i < nOp; ++i)
+                    {
+                        sum[(i*nMom_ + m)*rd + r] += val[i]*ph;
+                    }
+                }
+            }
+        }
+    });
+    thread_for(s, nSum*rd,
+    {
+        for (int thr = 1; thr < nthread; ++thr)
+        {
+            lvSum[s] += lvSum[thr*nSum*rd + s];
+        }
+    });
+    res.resize(nSum*fd);
+    for (auto &x: res)
+    {
+        x = Zero();
+    }
+    for (int s = 0; s < nSum; ++s)
+    for (int r = 0; r < rd; ++r)
+    {
+        extract(lvSum[s*rd + r], extracted);
+        for (int idx = 0; idx < Nsimd; idx++)
+        {
+            grid_->iCoorFromIindex(icoor, idx);
+            res[s*fd + tFirst + r + icoor[od]*rd] += extracted[idx];
+        }
+    }
+    grid_->GlobalSumVector(reinterpret_cast<Scalar *>(res.data()),
+                           res.size()*sizeof(sobj)/sizeof(Scalar));
+}
+
+template <typename vobj>
+void MomentumProjector::project(std::vector<typename vobj::scalar_object> &res,
+                                const std::vector<const Lattice<vobj> *> &op) const
+{
+    typedef decltype(op[0]->View(CpuRead)) View;
+
+    const int         nOp = op.size();
+    std::vector<View> op_v;
+
+    for (int i = 0; i < nOp; ++i)
+    {
+        if (op[i]->Grid() != grid_)
+        {
+            HADRONS_ERROR(Size, "field and momentum projector grids differ");
+        }
+        op_v.push_back(op[i]->View(CpuRead));
+    }
+    projectSites<vobj>(res, nOp, [&op_v, nOp](const int ss, vobj *val)
+    {
+        for (int i = 0; i < nOp; ++i)
+        {
+            val[i] = op_v[i][ss];
+        }
+    });
+    for (auto &v: op_v)
+    {
+        v.ViewClose();
+    }
+}
+
+template <typename vobj>
+void MomentumProjector::project(std::vector<typename vobj::scalar_object> &res,
+                                const std::vector<Lattice<vobj>> &op) const
+{
+    std::vector<const Lattice<vobj> *> ptr;
+
+    for (auto &f: op)
+    {
+        ptr.push_back(&f);
+    }
+    project(res, ptr);
+}
+
+template <typename vobj>
+void MomentumProjector::project(std::vector<typename vobj::scalar_object> &res,
+                                const Lattice<vobj> &op) const
+{
+    project(res, std::vector<const Lattice<vobj> *>{&op});
+}
+
+END_HADRONS_NAMESPACE
+
+#endif // Hadrons_MomentumProjector_hpp_
@@ -163,6 +163,135 @@ public:
         read(r, bValidate, Tag);
     }
     inline void read (const std::string &FileName, bool bValidate= true) { return read(FileName, bValidate, Name_); }
+
+    /**************************************************************************
+     Chunked block I/O (HDF5 only)
+     The file has the same layout as the one produced by write(), so it can be
+     read back in one piece with read(), but the tensor dataset is chunked so
+     that it can be filled and read back one sub-block at a time.
+     **************************************************************************/
+    using IndexArray = std::array<Index, NumIndices_>;
+
+#ifdef HAVE_HDF5
+    // Dimensions of the dataset: the tensor indices followed by the container ones
+    static std::vector<hsize_t> datasetDims(const IndexArray &d)
+    {
+        std::vector<hsize_t> dims;
+        for (int i = 0; i < NumIndices_; i++)
+            dims.push_back(static_cast<hsize_t>(d[i]));
+        for (int i = 0; i < Traits::Rank; i++)
+            dims.push_back(static_cast<hsize_t>(Traits::Dimension(i)));
+        return dims;
+    }
+    static std::vector<hsize_t> datasetOffset(const IndexArray &o)
+    {
+        std::vector<hsize_t> offset(NumIndices_ + Traits::Rank, 0);
+        for (int i = 0; i < NumIndices_; i++)
+            offset[i] = static_cast<hsize_t>(o[i]);
+        return offset;
+    }
+    IndexArray dimensionArray() const
+    {
+        IndexArray d;
+        for (int i = 0; i < NumIndices_; i++)
+            d[i] = tensor.dimension(i);
+        return d;
+    }
+#endif
+
+    // Create a file with index names and metadata and an empty tensor of my size
+    void initChunkedFile(const std::string &FileName, const std::string &Tag,
+                         const IndexArray &Chunk) const
+    {
+#ifdef HAVE_HDF5
+        std::string FileName_{FileName};
+        FileName_.append( NamedTensorFileExtension );
+        LOG(Message) << "Initialising chunked " << Name_ << " file " << FileName_ << " tag " << Tag << std::endl;
+        {
+            Hdf5Writer w( FileName_ );
+            push(w, Tag);
+            Grid::write(w, "IndexNames", IndexNames);
+            Grid::write(w, "MetaData", MetaData);
+            pop(w);
+        }
+        Hdf5Reader r( FileName_, false );
+        push(r, Tag);
+        std::vector<hsize_t>    dims{datasetDims(dimensionArray())}, chunk{datasetDims(Chunk)};
+        H5NS::DataSpace         dataspace(dims.size(), dims.data());
+        H5NS::DSetCreatPropList plist;
+        plist.setChunk(chunk.size(), chunk.data());
+        plist.setFletcher32();
+        r.getGroup().createDataSet("tensor", Hdf5Type<typename Traits::scalar_type>::type(),
+                                   dataspace, plist);
+#else
+        HADRONS_ERROR(Implementation, "chunked NamedTensor I/O needs HDF5 library");
+#endif
+    }
+    void initChunkedFile(const std::string &FileName, const IndexArray &Chunk) const
+    { initChunkedFile(FileName, Name_, Chunk); }
+
+    // Write the block [Offset, Offset + Extent) of my tensor to the same block on file
+    void writeBlock(const std::string &FileName, const std::string &Tag,
+                    const IndexArray &Offset, const IndexArray &Extent) const
+    {
+#ifdef HAVE_HDF5
+        Hdf5Reader r( FileName + NamedTensorFileExtension, false );
+        push(r, Tag);
+        H5NS::DataSet        dataset{r.getGroup().openDataSet("tensor")};
+        H5NS::DataSpace      dataspace{dataset.getSpace()};
+        std::vector<hsize_t> dims{datasetDims(dimensionArray())}, count{datasetDims(Extent)},
+                             offset{datasetOffset(Offset)};
+        H5NS::DataSpace      memspace(dims.size(), dims.data());
+        memspace.selectHyperslab(H5S_SELECT_SET, count.data(), offset.data());
+        dataspace.selectHyperslab(H5S_SELECT_SET, count.data(), offset.data());
+        dataset.write(EigenIO::getFirstScalar(tensor),
+                      Hdf5Type<typename Traits::scalar_type>::type(), memspace, dataspace);
+#else
+        HADRONS_ERROR(Implementation, "chunked NamedTensor I/O needs HDF5 library");
+#endif
+    }
+    void writeBlock(const std::string &FileName, const IndexArray &Offset, const IndexArray &Extent) const
+    { writeBlock(FileName, Name_, Offset, Extent); }
+
+    // Read the block of the file starting at Offset with the extent of my tensor
+    void readBlock(const std::string &FileName, bool bValidate, const std::string &Tag,
+                   const IndexArray &Offset)
+    {
+#ifdef HAVE_HDF5
+        Hdf5Reader r( FileName + NamedTensorFileExtension );
+        push(r, Tag);
+        std::vector<std::string> FileIndexNames;
+        Grid::read(r, "IndexNames", FileIndexNames);
+        if (bValidate && !ValidateIndexNames(FileIndexNames))
+        {
+            HADRONS_ERROR(Definition,"NamedTensor::readBlock dimension name");
+        }
+        Grid::read(r, "MetaData", MetaData);
+        H5NS::DataSet        dataset{r.getGroup().openDataSet("tensor")};
+        H5NS::DataSpace      dataspace{dataset.getSpace()};
+        std::vector<hsize_t> count{datasetDims(dimensionArray())}, offset{datasetOffset(Offset)},
+                             fileDims(dataspace.getSimpleExtentNdims());
+        dataspace.getSimpleExtentDims(fileDims.data());
+        if (fileDims.size() != count.size())
+        {
+            HADRONS_ERROR(Size,"NamedTensor::readBlock tensor rank");
+        }
+        for (int i = 0; i < count.size(); i++)
+            if (offset[i] + count[i] > fileDims[i])
+            {
+                HADRONS_ERROR(Size,"NamedTensor::readBlock block out of range in dimension "
+                              + std::to_string(i));
+            }
+        H5NS::DataSpace memspace(count.size(), count.data());
+        dataspace.selectHyperslab(H5S_SELECT_SET, count.data(), offset.data());
+        dataset.read(EigenIO::getFirstScalar(tensor),
+                     Hdf5Type<typename Traits::scalar_type>::type(), memspace, dataspace);
+#else
+        HADRONS_ERROR(Implementation, "chunked NamedTensor I/O needs HDF5 library");
+#endif
+    }
+    void readBlock(const std::string &FileName, const IndexArray &Offset, bool bValidate = true)
+    { readBlock(FileName, bValidate, Name_, Offset); }
 };
 
 /******************************************************************************
@@ -0,0 +1,170 @@
+/*
+ * SparseLattice.hpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+#ifndef Hadrons_SparseLattice_hpp_
+#define Hadrons_SparseLattice_hpp_
+
+#include <Hadrons/Global.hpp>
+
+BEGIN_HADRONS_NAMESPACE
+
+/******************************************************************************
+ *                    Fine lattice to sparse lattice map                      *
+ ******************************************************************************/
+// A sparse lattice keeps one site out of every block of blockSize[mu] sites
+// of a fine lattice, it is stored as an ordinary field on the coarse grid
+// (fine dimensions divided by blockSize, same MPI layout), with its own SIMD
+// layout. In the spatial directions the kept site of each block is offset by
+// shift[t][mu] < blockSize[mu], which can depend on the global time slice t,
+// in time the first site of each block is kept. The map from sparse sites to
+// fine sites (outer site and SIMD lane) is computed once, so that fields are
+// sparsened in a single pass over the sparse volume, without any coordinate
+// computation.
+class SparseLatticeMap
+{
+public:
+    // constructor
+    SparseLatticeMap(GridBase *fine, GridBase *sparse,
+                     const std::vector<int> &blockSize,
+                     const std::vector<std::vector<unsigned int>> &shift);
+    virtual ~SparseLatticeMap(void) = default;
+    // access
+    GridBase * fineGrid(void) const;
+    GridBase * sparseGrid(void) const;
+    // copy the sparse sites of fine into sparse
+    template <typename vobj>
+    void gather(Lattice<vobj> &sparse, const Lattice<vobj> &fine) const;
+private:
+    GridBase         *fine_, *sparse_;
+    std::vector<int> fineOsite_, fineLane_;
+};
+
+/******************************************************************************
+ *                      SparseLatticeMap implementation                       *
+ ******************************************************************************/
+inline SparseLatticeMap::SparseLatticeMap(GridBase *fine, GridBase *sparse,
+                                          const std::vector<int> &blockSize,
+                                          const std::vector<std::vector<unsigned int>> &shift)
+: fine_(fine), sparse_(sparse)
+{
+    const int nd    = fine_->_ndimension;
+    const int tdir  = nd - 1;
+    const int Nsimd = sparse_->Nsimd();
+
+    if ((sparse_->_ndimension != nd) or (blockSize.size() != nd))
+    {
+        HADRONS_ERROR(Size, "sparse lattice dimension mismatch");
+    }
+    for (int mu = 0; mu < nd; ++mu)
+    {
+        if (fine_->_ldimensions[mu] != sparse_->_ldimensions[mu]*blockSize[mu])
+        {
+            HADRONS_ERROR(Size, "local fine dimension " + std::to_string(mu) + " ("
+                          + std::to_string(fine_->_ldimensions[mu])
+                          + ") is not the local sparse dimension ("
+                          + std::to_string(sparse_->_ldimensions[mu])
+                          + ") times the block size ("
+                          + std::to_string(blockSize[mu]) + ")");
+        }
+    }
+    if (shift.size() != fine_->_fdimensions[tdir])
+    {
+        HADRONS_ERROR(Size, "sparse lattice shifts needed for "
+                      + std::to_string(fine_->_fdimensions[tdir]) + " time slices");
+    }
+    for (auto &s: shift)
+    {
+        if (s.size() != tdir)
+        {
+            HADRONS_ERROR(Size, "sparse lattice shift has " + std::to_string(s.size())
+                          + " components instead of " + std::to_string(tdir));
+        }
+        for (int mu = 0; mu < tdir; ++mu)
+        {
+            if (s[mu] >= blockSize[mu])
+            {
+                HADRONS_ERROR(Range, "sparse lattice shift larger than the block size");
+            }
+        }
+    }
+    fineOsite_.resize(sparse_->oSites()*Nsimd);
+    fineLane_.resize(sparse_->oSites()*Nsimd);
+    thread_for(o, sparse_->oSites(),
+    {
+        Coordinate ocoor(nd), icoor(nd), fcoor(nd);
+
+        sparse_->oCoorFromOindex(ocoor, o);
+        for (int l = 0; l < Nsimd; ++l)
+        {
+            sparse_->iCoorFromIindex(icoor, l);
+            fcoor[tdir] = (ocoor[tdir] + icoor[tdir]*sparse_->_rdimensions[tdir])
+                          *blockSize[tdir];
+
+            const auto &s = shift[fine_->_lstart[tdir] + fcoor[tdir]];
+
+            for (int mu = 0; mu < tdir; ++mu)
+            {
+                fcoor[mu] = (ocoor[mu] + icoor[mu]*sparse_->_rdimensions[mu])
+                            *blockSize[mu] + s[mu];
+            }
+            fineOsite_[o*Nsimd + l] = fine_->oIndex(fcoor);
+            fineLane_[o*Nsimd + l]  = fine_->iIndex(fcoor);
+        }
+    });
+}
+
+inline GridBase * SparseLatticeMap::fineGrid(void) const
+{
+    return fine_;
+}
+
+inline GridBase * SparseLatticeMap::sparseGrid(void) const
+{
+    return sparse_;
+}
+
+template <typename vobj>
+void SparseLatticeMap::gather(Lattice<vobj> &sparse, const Lattice<vobj> &fine) const
+{
+    const int Nsimd = sparse_->Nsimd();
+
+    if ((sparse.Grid() != sparse_) or (fine.Grid() != fine_))
+    {
+        HADRONS_ERROR(Size, "field grids do not match the sparse lattice map");
+    }
+    autoView(sparse_v, sparse, CpuWrite);
+    autoView(fine_v, fine, CpuRead);
+    thread_for(o, sparse_->oSites(),
+    {
+        for (int l = 0; l < Nsimd; ++l)
+        {
+            const int i = o*Nsimd + l;
+
+            insertLane(l, sparse_v[o], extractLane(fineLane_[i], fine_v[fineOsite_[i]]));
+        }
+    });
+}
+
+END_HADRONS_NAMESPACE
+
+#endif // Hadrons_SparseLattice_hpp_
@@ -189,6 +189,11 @@ bool VirtualMachine::hasDatabase(void) const
     return ((db_ != nullptr) and db_->isConnected());
 }
 
+Database * VirtualMachine::getDatabase(void) const
+{
+    return hasDatabase() ? db_ : nullptr;
+}
+
 void VirtualMachine::initDatabase(void)
 {
     db_->execute("PRAGMA foreign_keys = ON;");
@@ -864,6 +869,13 @@ VirtualMachine::Size VirtualMachine::memoryNeeded(const Program &p)
     return max;
 }
 
+VirtualMachine::Size VirtualMachine::getMemoryBudget(void) const
+{
+    Size current = env().getTotalSize();
+
+    return (memoryPeak_ > current) ? (memoryPeak_ - current) : 0;
+}
+
 // genetic scheduler ///////////////////////////////////////////////////////////
 VirtualMachine::Program VirtualMachine::schedule(const GeneticPar &par)
 {
@@ -950,6 +962,8 @@ void VirtualMachine::executeProgram(const Program &p)
     // build garbage collection schedule
     LOG(Debug) << "Building garbage collection schedule..." << std::endl;
     freeProg = makeGarbageSchedule(p);
+    // the profile is never rebuilt here, it would run all module setups
+    memoryPeak_ = memoryProfileOutdated_ ? 0 : memoryNeeded(p);
     for (unsigned int i = 0; i < freeProg.size(); ++i)
     {
         std::string msg = "";
@@ -144,6 +144,7 @@ public:
     void                dbRestoreMemoryProfile(void);
     void                dbRestoreModules(void);
     Program             dbRestoreSchedule(void);
+    Database *          getDatabase(void) const;
     // module management
     void                pushModule(ModPt &pt);
     template <typename M>
@@ -186,6 +187,9 @@ public:
     GarbageSchedule     makeGarbageSchedule(const Program &p) const;
     // high-water memory function
     Size                memoryNeeded(const Program &p);
+    // memory that can be used outside the environment during the current
+    // program without raising its high-water mark
+    Size                getMemoryBudget(void) const;
     // genetic scheduler
     Program             schedule(const GeneticPar &par);
     // general execution
@@ -228,6 +232,7 @@ private:
     // memory profile
     bool                                memoryProfileOutdated_{true};
     MemoryProfile                       profile_;     
+    Size                                memoryPeak_{0};
     // time profile
     GridTime                            totalTime_;
     std::map<std::string, GridTime>     timeProfile_;               
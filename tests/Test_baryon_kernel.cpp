@@ -0,0 +1,94 @@
+/*
+ * Test_baryon_kernel.cpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+
+#include <Hadrons/Environment.hpp>
+#include <Hadrons/Modules/MContraction/Baryon.hpp>
+
+using namespace Grid;
+using namespace Hadrons;
+
+int main(int argc, char *argv[])
+{
+    Grid_init(&argc, &argv);
+    initLogger();
+
+    bool ok = true;
+
+#if (!defined(GRID_HIP))
+    typedef MContraction::BaryonKernel<FIMPL> Kernel;
+
+    auto                       &env = Environment::getInstance();
+    auto                       *grid = env.getGrid();
+    GridParallelRNG            rng(grid);
+    LatticePropagator          q1(grid), q2(grid), q3(grid);
+    LatticeComplex             c(grid), cRef(grid);
+    Kernel::SpinMatrixField    cMat(grid), cMatRef(grid);
+    const Gamma::Algebra       cg5 = Gamma::Algebra::SigmaXZ, id = Gamma::Algebra::Identity;
+    std::vector<MContraction::GammaABPair> gammaList = 
+        {{{cg5, id}, {cg5, id}}, {{cg5, Gamma::Algebra::GammaT}, {cg5, id}}};
+    std::vector<std::pair<std::string, std::string>> quarks = 
+        {{"uud", "uud"}, {"uds", "uds"}, {"sss", "sss"}};
+    
+    rng.SeedFixedIntegers({1, 2, 3, 4});
+    random(rng, q1);
+    random(rng, q2);
+    random(rng, q3);
+    for (auto &g: gammaList)
+    for (auto &q: quarks)
+    for (int parity: {1, -1})
+    {
+        int    wick;
+        Gamma  gAl(g.first.first), gBl(g.first.second);
+        Gamma  gAr(g.second.first), gBr(g.second.second);
+        double diff, diffMat;
+
+        BaryonUtils<FIMPL>::WickContractions(q.first, q.second, wick);
+
+        const Kernel kernel(g, wick, parity);
+
+        // reference: BaryonUtils lattice kernels
+        cRef = Zero();
+        BaryonUtils<FIMPL>::ContractBaryons(q1, q2, q3, gAl, gBl, gAr, gBr, 
+                                            wick, parity, cRef);
+        cMatRef = Zero();
+        BaryonUtils<FIMPL>::ContractBaryonsMatrix(q1, q2, q3, gAl, gBl, gAr, gBr,
+                                                  wick, cMatRef);
+        kernel(c, q1, q2, q3);
+        kernel(cMat, q1, q2, q3);
+        diff    = std::sqrt(norm2(c - cRef)/norm2(cRef));
+        diffMat = std::sqrt(norm2(cMat - cMatRef)/norm2(cMatRef));
+        LOG(Message) << "quarks " << q.first << " -> " << q.second << ", parity " 
+                     << parity << ", gammas (" << g.first.first << " " 
+                     << g.first.second << ") (" << g.second.first << " " 
+                     << g.second.second << "): relative difference " << diff 
+                     << " (trace) " << diffMat << " (matrix)" << std::endl;
+        ok = ok and (diff < 1.0e-5) and (diffMat < 1.0e-5);
+    }
+#endif
+    LOG(Message) << "baryon kernel correct? " << (ok ? "yes" : "no") << std::endl;
+
+    Grid_finalize();
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
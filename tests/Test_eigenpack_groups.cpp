@@ -0,0 +1,102 @@
+/*
+ * Test_eigenpack_groups.cpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+
+#include <Hadrons/Global.hpp>
+#include <Hadrons/EigenPack.hpp>
+
+using namespace Grid;
+using namespace Hadrons;
+
+// write a multi-file pack of odd-checkerboard random vectors, read it back
+// with the serial reader and the I/O group reader and return the relative
+// difference between the two
+double testPack(const std::string filename, GridCartesian *grid, 
+                GridRedBlackCartesian *rbGrid, const unsigned int size,
+                const unsigned int nGroups)
+{
+    GridParallelRNG             rng(grid);
+    LatticeFermion              full(grid);
+    std::vector<LatticeFermion> evec(size, rbGrid), ref(size, rbGrid), 
+                                res(size, rbGrid);
+    std::vector<RealD>          eval(size), evalRef(size), evalRes(size);
+    PackRecord                  record;
+    double                      diff = 0., norm = 0.;
+
+    rng.SeedFixedIntegers({1, 2, 3, 4});
+    record.operatorXml = "<operator></operator>";
+    record.solverXml   = "<solver></solver>";
+    for (unsigned int k = 0; k < size; ++k)
+    {
+        gaussian(rng, full);
+        pickCheckerboard(Odd, evec[k], full);
+        eval[k] = 0.1*(k + 1);
+    }
+    EigenPackIo::writePack<LatticeFermion>(filename, evec, eval, record, size, true);
+    EigenPackIo::readPack<LatticeFermion>(ref, evalRef, record, filename, size, true);
+    EigenPackIo::readPackGroups<LatticeFermion>(res, evalRes, record, filename, 
+                                                size, nGroups, grid);
+    for (unsigned int k = 0; k < size; ++k)
+    {
+        if (res[k].Checkerboard() != ref[k].Checkerboard())
+        {
+            return 1.;
+        }
+        diff += norm2(res[k] - ref[k]) + (evalRes[k] - evalRef[k])*(evalRes[k] - evalRef[k]);
+        norm += norm2(ref[k]) + evalRef[k]*evalRef[k];
+    }
+
+    return std::sqrt(diff/norm);
+}
+
+int main(int argc, char *argv[])
+{
+    Grid_init(&argc, &argv);
+    initLogger();
+
+    const unsigned int    Ls      = 4, size = 5;
+    GridCartesian         *grid4  = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), 
+                                        GridDefaultSimd(Nd, vComplex::Nsimd()),
+                                        GridDefaultMpi());
+    GridRedBlackCartesian *rbGrid4 = SpaceTimeGrid::makeFourDimRedBlackGrid(grid4);
+    GridCartesian         *grid5   = SpaceTimeGrid::makeFiveDimGrid(Ls, grid4);
+    GridRedBlackCartesian *rbGrid5 = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls, grid4);
+    unsigned int          nGroups  = (grid4->_Nprocessors % 2 == 0) ? 2 : 1;
+    double                diff4, diff5;
+    bool                  ok;
+
+    // size is odd so the last pass of the group reader is padded
+    LOG(Message) << "Reading with " << nGroups << " I/O group(s)" << std::endl;
+    diff4 = testPack("eigenpack_groups_test_4d", grid4, rbGrid4, size, nGroups);
+    diff5 = testPack("eigenpack_groups_test_5d", grid5, rbGrid5, size, nGroups);
+    ok    = (diff4 < 1.0e-5) and (diff5 < 1.0e-5);
+    LOG(Message) << "4D red-black relative difference with serial reader: " 
+                 << diff4 << std::endl;
+    LOG(Message) << "5D red-black relative difference with serial reader: " 
+                 << diff5 << std::endl;
+    LOG(Message) << "group read correct? " << (ok ? "yes" : "no") << std::endl;
+
+    Grid_finalize();
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,81 @@
+/*
+ * Test_fft_batch.cpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+
+#include <Hadrons/Environment.hpp>
+
+using namespace Grid;
+using namespace Hadrons;
+
+typedef FftService::PackedField<LatticeComplex> PackedField;
+
+int main(int argc, char *argv[])
+{
+    Grid_init(&argc, &argv);
+    initLogger();
+
+    auto                        &env  = Environment::getInstance();
+    auto                        *grid = env.getGrid();
+    const unsigned int          nd    = grid->_ndimension;
+    // one full batch and a partial one
+    const unsigned int          nField = HADRONS_FFT_BATCH + 2;
+    std::vector<int>            mask(nd, 1);
+    GridParallelRNG             rng(grid);
+    std::vector<LatticeComplex> in(nField, LatticeComplex(grid));
+    std::vector<LatticeComplex> out(nField, LatticeComplex(grid));
+    LatticeComplex              ref(grid);
+    PackedField                 packed(grid), packedFt(grid);
+    FFT                         fft(grid);
+    double                      diff = 0., norm = 0.;
+
+    rng.SeedFixedIntegers({1, 2, 3, 4});
+    for (auto &f: in)
+    {
+        random(rng, f);
+    }
+    mask.back() = 0;
+
+    // batched spatial FFT
+    auto &transform = env.getFft().getSpatialTransform(grid);
+
+    transform(out, in, FFT::forward, packed, packedFt);
+
+    // reference: one FFT per field
+    for (unsigned int i = 0; i < nField; ++i)
+    {
+        fft.FFT_dim_mask(ref, in[i], mask, FFT::forward);
+        diff += norm2(out[i] - ref);
+        norm += norm2(ref);
+    }
+    diff = std::sqrt(diff/norm);
+    LOG(Message) << "relative difference with per-field FFT: " << diff 
+                 << std::endl;
+    LOG(Message) << "batched FFT correct? " << ((diff < 1.0e-5) ? "yes" : "no")
+                 << std::endl;
+    LOG(Message) << "fields transformed: " << transform.fieldCount() 
+                 << std::endl;
+
+    Grid_finalize();
+
+    return (diff < 1.0e-5) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,91 @@
+/*
+ * Test_momentum_projector.cpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+
+#include <Hadrons/Environment.hpp>
+#include <Hadrons/MomentumProjector.hpp>
+
+using namespace Grid;
+using namespace Hadrons;
+
+int main(int argc, char *argv[])
+{
+    Grid_init(&argc, &argv);
+    initLogger();
+
+    auto                           &env  = Environment::getInstance();
+    auto                           *grid = env.getGrid();
+    const unsigned int             nd    = grid->_ndimension;
+    const unsigned int             nt    = grid->_fdimensions[Tp];
+    const unsigned int             nOp   = 3;
+    std::vector<std::vector<Real>> mom   = {{0., 0., 0.}, {1., 0., 0.},
+                                            {1., -2., 1.}};
+    GridParallelRNG                rng(grid);
+    std::vector<LatticeComplex>    op(nOp, LatticeComplex(grid));
+    LatticeComplex                 coor(grid), phase(grid);
+    std::vector<TComplex>          res, ref;
+    Complex                        i(0., 1.);
+    double                         diff = 0., norm = 0.;
+
+    rng.SeedFixedIntegers({1, 2, 3, 4});
+    for (auto &o: op)
+    {
+        random(rng, o);
+    }
+
+    // batched projection
+    MomentumProjector proj(grid, mom, Tp);
+
+    proj.project(res, op);
+
+    // reference: phase field and sliceSum, one field and momentum at a time
+    for (unsigned int m = 0; m < mom.size(); ++m)
+    {
+        phase = Zero();
+        for (unsigned int mu = 0; mu < nd - 1; ++mu)
+        {
+            LatticeCoordinate(coor, mu);
+            phase = phase + (2.*M_PI*mom[m][mu]/grid->_fdimensions[mu])*coor;
+        }
+        phase = exp(i*phase);
+        for (unsigned int o = 0; o < nOp; ++o)
+        {
+            coor = phase*op[o];
+            sliceSum(coor, ref, Tp);
+            for (unsigned int t = 0; t < nt; ++t)
+            {
+                diff += std::norm(TensorRemove(res[(o*mom.size() + m)*nt + t])
+                                  - TensorRemove(ref[t]));
+                norm += std::norm(TensorRemove(ref[t]));
+            }
+        }
+    }
+    diff = std::sqrt(diff/norm);
+    LOG(Message) << "relative difference with sliceSum: " << diff << std::endl;
+    LOG(Message) << "projection correct? " << ((diff < 1.0e-5) ? "yes" : "no")
+                 << std::endl;
+
+    Grid_finalize();
+
+    return (diff < 1.0e-5) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
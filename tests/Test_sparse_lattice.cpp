@@ -0,0 +1,87 @@
+/*
+ * Test_sparse_lattice.cpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+
+#include <Hadrons/Environment.hpp>
+#include <Hadrons/SparseLattice.hpp>
+
+using namespace Grid;
+using namespace Hadrons;
+
+int main(int argc, char *argv[])
+{
+    Grid_init(&argc, &argv);
+    initLogger();
+
+    auto                                   &env      = Environment::getInstance();
+    const unsigned int                     nd        = env.getNd();
+    const unsigned int                     tdir      = nd - 1;
+    std::vector<int>                       blockSize(nd, 2);
+    auto                                   *fine     = env.getGrid();
+    auto                                   *sparse   = env.getCoarseGrid(blockSize);
+    const unsigned int                     nt        = fine->_fdimensions[tdir];
+    std::vector<std::vector<unsigned int>> shift(nt, std::vector<unsigned int>(tdir));
+    GridParallelRNG                        rng(fine);
+    LatticeComplex                         fineField(fine), sparseField(sparse);
+    Coordinate                             xs(nd), xf(nd);
+    TComplex                               vs, vf;
+    unsigned int                           nBad = 0;
+
+    // time-dependent shifts, identical on all ranks
+    for (unsigned int t = 0; t < nt; ++t)
+    for (unsigned int mu = 0; mu < tdir; ++mu)
+    {
+        shift[t][mu] = (t + mu) % blockSize[mu];
+    }
+    rng.SeedFixedIntegers({1, 2, 3, 4});
+    random(rng, fineField);
+
+    SparseLatticeMap map(fine, sparse, blockSize, shift);
+
+    map.gather(sparseField, fineField);
+
+    // every sparse site must hold the value of its fine site
+    for (int64_t idx = 0; idx < sparse->gSites(); ++idx)
+    {
+        Lexicographic::CoorFromIndex(xs, idx, sparse->_fdimensions);
+        xf[tdir] = xs[tdir]*blockSize[tdir];
+        for (unsigned int mu = 0; mu < tdir; ++mu)
+        {
+            xf[mu] = xs[mu]*blockSize[mu] + shift[xf[tdir]][mu];
+        }
+        peekSite(vs, sparseField, xs);
+        peekSite(vf, fineField, xf);
+        if (TensorRemove(vs) != TensorRemove(vf))
+        {
+            nBad++;
+        }
+    }
+    LOG(Message) << "sparse sites checked: " << sparse->gSites() 
+                 << ", mismatches: " << nBad << std::endl;
+    LOG(Message) << "sparse gather correct? " << ((nBad == 0) ? "yes" : "no")
+                 << std::endl;
+
+    Grid_finalize();
+
+    return (nBad == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,109 @@
+/*
+ * Test_stag_a2a_transport.cpp, part of Hadrons (https://github.com/aportelli/Hadrons)
+ *
+ * Copyright (C) 2015 - 2020
+ *
+ * Hadrons is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Hadrons is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Hadrons.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * See the full license in the file "LICENSE" in the top level distribution
+ * directory.
+ */
+
+/*  END LEGAL */
+
+#include <Hadrons/Application.hpp>
+#include <Hadrons/Modules/MContraction/StagA2AMesonFieldCC.hpp>
+
+using namespace Grid;
+using namespace Hadrons;
+
+typedef STAGIMPL::FermionField                                  FermionField;
+typedef MContraction::StagMesonFieldCCKernel<Complex, STAGIMPL> Kernel;
+
+// Compares the two paths of MContraction::StagA2AMesonFieldCC on a few random
+// vectors: the Grid conserved current kernel (transportCache = 0) and the
+// plain inner product with the right modes multiplied by the link
+// (transportCache > 0), mode 2k being the vector k and mode 2k+1 its product
+// with the parity sign.
+int main(int argc, char *argv[])
+{
+    Grid_init(&argc, &argv);
+    initLogger();
+
+    auto                        &env  = Environment::getInstance();
+    auto                        *grid = env.getGrid();
+    const unsigned int          nt    = grid->_fdimensions[Tp];
+    const unsigned int          nVec  = 2, nMode = 2*nVec;
+    const int                   mu    = 0;
+    std::vector<Gamma::Algebra> gamma = {Gamma::Algebra::GammaX};
+    GridParallelRNG             rng(grid);
+    LatticeGaugeField           U(grid);
+    LatticeColourMatrix         Umu(grid);
+    std::vector<LatticeComplex> ph(1, LatticeComplex(grid));
+    std::vector<FermionField>   evec(nVec, FermionField(grid));
+    std::vector<FermionField>   left(nMode, FermionField(grid));
+    std::vector<FermionField>   right(nMode, FermionField(grid));
+    Lattice<iScalar<vInteger>>  coor(grid), sum(grid);
+    Vector<Complex>             bufRef(nt*nMode*nMode), buf(nt*nMode*nMode);
+    A2AMatrixSet<Complex>       mRef(bufRef.data(), 1, 1, nt, nMode, nMode);
+    A2AMatrixSet<Complex>       m(buf.data(), 1, 1, nt, nMode, nMode);
+    Kernel                      kernelRef(gamma, ph, grid);
+    Kernel                      kernel(gamma, ph, grid, true);
+    double                      t, diff = 0., norm = 0.;
+
+    rng.SeedFixedIntegers({1, 2, 3, 4});
+    SU<Nc>::HotConfiguration(rng, U);
+    Umu = PeekIndex<LorentzIndex>(U, mu);
+    for (auto &v: evec)
+    {
+        gaussian(rng, v);
+    }
+    // parity sign, as in the module
+    sum = Zero();
+    for (unsigned int d = 0; d < grid->_ndimension; ++d)
+    {
+        LatticeCoordinate(coor, d);
+        sum = sum + coor;
+    }
+    ph[0] = 1.;
+    ph[0] = where(mod(sum, 2) == (Integer)0, ph[0], -ph[0]);
+
+    // transportCache = 0
+    kernelRef(mRef, mu, Umu, evec.data(), evec.data(), Tp, t);
+
+    // transportCache > 0
+    for (unsigned int i = 0; i < nMode; ++i)
+    {
+        left[i]  = (i % 2) ? FermionField(ph[0]*evec[i/2]) : evec[i/2];
+        right[i] = Umu*Cshift(left[i], mu, 1);
+    }
+    kernel(m, left.data(), right.data(), Tp, t);
+
+    for (unsigned int tt = 0; tt < nt; ++tt)
+    for (unsigned int i = 0; i < nMode; ++i)
+    for (unsigned int j = 0; j < nMode; ++j)
+    {
+        diff += std::norm(m(0, 0, tt, i, j) - mRef(0, 0, tt, i, j));
+        norm += std::norm(mRef(0, 0, tt, i, j));
+    }
+    diff = std::sqrt(diff/norm);
+    LOG(Message) << "relative difference between the two paths: " << diff 
+                 << std::endl;
+    LOG(Message) << "transported meson field correct? " 
+                 << ((diff < 1.0e-5) ? "yes" : "no") << std::endl;
+
+    Grid_finalize();
+
+    return (diff < 1.0e-5) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -271,15 +271,21 @@ int main(int argc, char* argv[])
     // parse command line
     std::string   parFilename;
 
-    if (argc != 2)
+    if (argc < 2)
     {
-        std::cerr << "usage: " << argv[0] << " <parameter file>";
+        std::cerr << "usage: " << argv[0] << " <parameter file> [grid options]";
         std::cerr << std::endl;
         
         return EXIT_FAILURE;
     }
     parFilename = argv[1];
 
+    // initialization, the disk vectors are shared by all ranks: the boss rank
+    // does the disk I/O and broadcasts the tensors
+    Grid_init(&argc, &argv);
+
+    GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(4,1), GridDefaultMpi());
+
     // parse parameter file
     ContractorPar par;
     TimerArray tAr;
@@ -300,7 +306,7 @@ int main(int argc, char* argv[])
     {
         std::string dirName = par.global.diskVectorDir + "/" + p.name;
 
-        a2aMatNuc.emplace(p.name, EigenDiskVectorNuc<HADRONS_A2AN_CALC_TYPE>(dirName, par.global.nt, p.cacheSize));
+        a2aMatNuc.emplace(p.name, EigenDiskVectorNuc<HADRONS_A2AN_CALC_TYPE>(dirName, par.global.nt, p.cacheSize, true, grid));
     }
 
     // trajectory loop
@@ -371,6 +377,7 @@ int main(int argc, char* argv[])
             std::set<unsigned int>                 translations;
             std::vector<A2AMatrixNuc<HADRONS_A2AN_CALC_TYPE>>    lastTerm(par.global.nt);
             A2AMatrixNuc<HADRONS_A2AN_CALC_TYPE>                 tenW;
+            A2AMatrixNuc<HADRONS_A2AN_CALC_TYPE>                 tenWAsym;
             //A2AMatrixNuc<ComplexD>                 prod;
             //TimerArray                             tAr;
             double                                 fusec, busec, flops, bytes, tusec;
@@ -459,17 +466,8 @@ int main(int argc, char* argv[])
                 tAr.stopTimer("Disk vector overhead");
 
                 tAr.startTimer("Last term caching");
-                lastTerm[t].resize(ref.dimension(0), ref.dimension(1), ref.dimension(2), ref.dimension(3));
-                thread_for(mu,ref.dimension(0),{
-                    thread_for(k,ref.dimension(3),{
-                        thread_for(j,ref.dimension(2),{
-                            for (unsigned int i = 0; i < ref.dimension(1); ++i)
-                            {
-                                lastTerm[t]((long)mu,(long)i,(long)j,(long)k) = ref((long)mu,(long)i,(long)j,(long)k);
-                            }
-                        });
-                    });
-                });
+                // same (mu,i,j,k) row-major layout as the disk vector: plain copy
+                lastTerm[t] = ref;
                 tAr.stopTimer("Last term caching");
             }
             bytes = par.global.nt*lastTerm[0].dimension(0)*lastTerm[0].dimension(1)*lastTerm[0].dimension(2)
@@ -523,18 +521,10 @@ int main(int argc, char* argv[])
                     busec  = tAr.getDTimer("A*B total"); // MCA - this also
                     tAr.startTimer("Linear algebra");
                     tAr.startTimer("Disk vector overhead");
-                    const A2AMatrixNuc<HADRONS_A2AN_CALC_TYPE> &ref = a2aMatNuc.at(term.back())[dt];
-                    tenW.resize(ref.dimension(0), ref.dimension(1), ref.dimension(2), ref.dimension(3));
- 		    thread_for(mu,ref.dimension(0),{
-                        thread_for(k,ref.dimension(3),{
-                            thread_for(j,ref.dimension(2),{
-                                for (unsigned int i = 0; i < ref.dimension(1); ++i)
-                                {
-                                    tenW((long)mu, (long)i, (long)j, (long)k) = ref((long)mu, (long)i, (long)j, (long)k);
-                                }
-                            });
-                        });
-                    });
+                    // the source tensor is used once per translation: read it
+                    // directly rather than through the cache
+                    a2aMatNuc.at(term.back()).loadSlab(tenW, dt, 0, 0);
+                    A2AContractionNucleon::antiSymNucTen(tenWAsym, tenW);
                     tAr.stopTimer("Disk vector overhead");
                     
                     flops  = 0.;
@@ -552,7 +542,7 @@ int main(int argc, char* argv[])
                         //tAr.startTimer("tr(A*B)"); // adjust this
                         
                         // do contractions
-                        A2AContractionNucleon::contNucTen(tmp_spinMat[TIME_MOD(tLast - dt)], lastTerm[tLast], tenW);
+                        A2AContractionNucleon::contNucTenAsym(tmp_spinMat[TIME_MOD(tLast - dt)], lastTerm[tLast], tenWAsym);
                         if (tLast < dt)
                         {
 			   tmp_spinMat[TIME_MOD(tLast - dt)] *= p.boundaryT;
@@ -573,7 +563,10 @@ int main(int argc, char* argv[])
                     // if we're not averaging over source times -- save data to file and flush correlator data
                     if (!p.translationAverage)
                     {
-                        saveCorrelator(result, p.output, dt, traj);
+                        if (grid->IsBoss())
+                        {
+                            saveCorrelator(result, p.output, dt, traj);
+                        }
                         for (unsigned int tLast = 0; tLast < par.global.nt; ++tLast)
                         {
                             //result.correlator[tLast] = 0.;
@@ -596,7 +589,10 @@ int main(int argc, char* argv[])
                         }
                         std::cout << tLast << " -- " << result.corr[tLast] << std::endl;
                     }
-                    saveCorrelator(result, p.output, 0, traj);
+                    if (grid->IsBoss())
+                    {
+                        saveCorrelator(result, p.output, 0, traj);
+                    }
                     
                     //std::cout << "Boundary condition in T direction is " << p.boundaryT << std::endl;
                     /*
@@ -614,6 +610,7 @@ int main(int argc, char* argv[])
     tAr.stopTimer("Total");
     printTimeProfile(tAr.getTimings(), tAr.getTimer("Total"));
     }
+    Grid_finalize();
     
     return EXIT_SUCCESS;
 }
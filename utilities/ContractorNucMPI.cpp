@@ -362,6 +362,7 @@ int main(int argc, char* argv[])
             std::set<unsigned int>                 translations;
             std::vector<A2AMatrixNuc<ComplexD>>    lastTerm(localNt);
             A2AMatrixNuc<ComplexD>                 tenW;
+            A2AMatrixNuc<ComplexD>                 tenWAsym;
             TimerArray                             tAr;
             double                                 fusec, busec, flops, bytes, tusec;
             Contractor::CorrelatorResult           result;
@@ -445,38 +446,39 @@ int main(int argc, char* argv[])
                 int srcNode = dt/localNt;
                 std::cout<<" dt= "<<dt<<" src node= "<<srcNode<<std::endl;
                 
-		uint64_t a2abytes; 
-                const A2AMatrixNuc<ComplexD> &ref = a2aMatNuc.at(term.back())[dt%localNt];
-                tenW.resize(ref.dimension(0), ref.dimension(1), ref.dimension(2), ref.dimension(3));
-		A2AMatrix3index<ComplexD> temp;
-                temp.resize(ref.dimension(1), ref.dimension(2), ref.dimension(3));
-                a2abytes = sizeof(ComplexD)*ref.dimension(1)*ref.dimension(2)*ref.dimension(3);
-		// do 1 spin at a time so MPI_bcast doesn't break
-                // thread_for broke something here
-                for(int mu=0;mu<ref.dimension(0);mu++)
-		{
-		    if(srcNode==Grid->ThisRank())
-		    {
-                       for(int k=0;k<ref.dimension(3);k++){
-                           for(int j=0;j<ref.dimension(2);j++){
-                               for (unsigned int i = 0; i < ref.dimension(1); i++)
-                               {
-		         	   temp((long)i,(long)j,(long)k) = ref((long)mu, (long)i, (long)j ,(long)k);
-                               }
-                            }
-                        }
+                // only the source rank reads the source tensor, one spin slab
+                // at a time (bypassing its cache), and broadcasts it; one spin
+                // at a time also keeps MPI_bcast sizes small. The (mu,i,j,k)
+                // layout is row-major so each spin slab is contiguous in tenW
+                auto                    &srcVec = a2aMatNuc.at(term.back());
+                A2AMatrixNuc<ComplexD>  slab;
+                uint64_t                dim[3], slabSize;
+
+                if (srcNode == Grid->ThisRank())
+                {
+                    srcVec.loadSlab(slab, dt%localNt, 0, 1);
+                    for (int d = 0; d < 3; d++)
+                    {
+                        dim[d] = slab.dimension(d + 1);
                     }
-                    Grid->Broadcast(srcNode, temp.data(), a2abytes);
-                    for(int k=0;k<ref.dimension(3);k++){
-                        for(int j=0;j<ref.dimension(2);j++){
-                           for (unsigned int i = 0; i < ref.dimension(1); i++)
-                           {
-                               tenW((long)mu, (long)i, (long)j, (long)k) = temp((long)i,(long)j,(long)k);
-                           }
+                }
+                Grid->Broadcast(srcNode, dim, sizeof(dim));
+                tenW.resize(Ns, dim[0], dim[1], dim[2]);
+                slabSize = dim[0]*dim[1]*dim[2];
+                for (int mu = 0; mu < Ns; mu++)
+                {
+                    if (srcNode == Grid->ThisRank())
+                    {
+                        if (mu > 0)
+                        {
+                            srcVec.loadSlab(slab, dt%localNt, mu, 1);
                         }
+                        std::copy(slab.data(), slab.data() + slabSize, tenW.data() + mu*slabSize);
                     }
+                    Grid->Broadcast(srcNode, tenW.data() + mu*slabSize, slabSize*sizeof(ComplexD));
                 }
  
+                A2AContractionNucleon::antiSymNucTen(tenWAsym, tenW);
                 tAr.stopTimer("Disk vector overhead");
                 
                 flops  = 0.;
@@ -489,7 +491,7 @@ int main(int argc, char* argv[])
                     int gt = TIME_MOD(tLast+Grid->ThisRank()*localNt - dt);
                     spinMatInit(tmp_spinMat[gt]);
                     tAr.startTimer("tr(A*B)"); // adjust this
-		    A2AContractionNucleon::contNucTen(tmp_spinMat[gt], lastTerm[tLast], tenW);
+		    A2AContractionNucleon::contNucTenAsym(tmp_spinMat[gt], lastTerm[tLast], tenWAsym);
                     // if antiperiodic (boundaryT = -1) do sign change for tsink < tsrc
                     if (tLast + Grid->ThisRank()*localNt < dt)
                     {